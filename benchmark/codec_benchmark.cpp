@@ -0,0 +1,84 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <openarm/damiao_motor/dm_motor.hpp>
+#include <openarm/damiao_motor/dm_motor_control.hpp>
+
+namespace {
+
+using openarm::damiao_motor::CanPacketDecoder;
+using openarm::damiao_motor::CanPacketEncoder;
+using openarm::damiao_motor::Motor;
+using openarm::damiao_motor::MotorType;
+
+const Motor motor(MotorType::DM4310, 0x01, 0x11);
+
+void BM_EncodeMITControl(benchmark::State& state) {
+    openarm::damiao_motor::MITParam param{30.0, 1.0, 0.5, 0.1, 0.2};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CanPacketEncoder::create_mit_control_command(motor, param));
+    }
+}
+BENCHMARK(BM_EncodeMITControl);
+
+void BM_EncodePosVelControl(benchmark::State& state) {
+    openarm::damiao_motor::PosVelParam param{0.5, 1.0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CanPacketEncoder::create_posvel_control_command(motor, param));
+    }
+}
+BENCHMARK(BM_EncodePosVelControl);
+
+void BM_EncodeVelControl(benchmark::State& state) {
+    openarm::damiao_motor::VelParam param{1.0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CanPacketEncoder::create_vel_control_command(motor, param));
+    }
+}
+BENCHMARK(BM_EncodeVelControl);
+
+void BM_EncodePosForceControl(benchmark::State& state) {
+    openarm::damiao_motor::PosForceParam param{0.5, 1.0, 0.5};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CanPacketEncoder::create_posforce_control_command(motor, param));
+    }
+}
+BENCHMARK(BM_EncodePosForceControl);
+
+void BM_EncodeQueryParam(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CanPacketEncoder::create_query_param_command(motor, 7));
+    }
+}
+BENCHMARK(BM_EncodeQueryParam);
+
+void BM_DecodeState(benchmark::State& state) {
+    const std::vector<uint8_t> data = {0x11, 0x80, 0x00, 0x80, 0x08, 0x00, 0x1E, 0x1F};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CanPacketDecoder::parse_motor_state_data(motor, data));
+    }
+}
+BENCHMARK(BM_DecodeState);
+
+void BM_DecodeParam(benchmark::State& state) {
+    const std::vector<uint8_t> data = {0x01, 0x00, 0x33, 0x07, 0x11, 0x00, 0x00, 0x00};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CanPacketDecoder::parse_motor_param_data(data));
+    }
+}
+BENCHMARK(BM_DecodeParam);
+
+}  // namespace
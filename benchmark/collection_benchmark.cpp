@@ -0,0 +1,102 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <openarm/can/socket/arm_component.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <vector>
+
+namespace {
+
+using openarm::damiao_motor::MotorType;
+
+// Exposes the protected device accessor for measurement
+class BenchArm : public openarm::can::socket::ArmComponent {
+public:
+    BenchArm(openarm::canbus::CANTransport& transport, int motor_count, bool use_fd)
+        : ArmComponent(transport) {
+        std::vector<MotorType> motor_types(motor_count, MotorType::DM4310);
+        std::vector<canid_t> send_can_ids;
+        std::vector<canid_t> recv_can_ids;
+        for (int i = 1; i <= motor_count; ++i) {
+            send_can_ids.push_back(i);
+            recv_can_ids.push_back(i + 0x10);
+        }
+        init_motor_devices(motor_types, send_can_ids, recv_can_ids, use_fd);
+        set_callback_mode_all(openarm::damiao_motor::CallbackMode::STATE);
+    }
+    using ArmComponent::get_dm_devices;
+};
+
+template <typename Frame>
+std::vector<Frame> make_state_frames(int motor_count) {
+    const uint8_t state[8] = {0x11, 0x80, 0x00, 0x80, 0x08, 0x00, 0x1E, 0x1F};
+    std::vector<Frame> frames(motor_count);
+    for (int i = 0; i < motor_count; ++i) {
+        std::memset(&frames[i], 0, sizeof(Frame));
+        frames[i].can_id = i + 1 + 0x10;
+        std::memcpy(frames[i].data, state, sizeof(state));
+    }
+    return frames;
+}
+
+void BM_DispatchCANFrame(benchmark::State& state) {
+    const int motor_count = state.range(0);
+    openarm::canbus::LoopbackTransport transport;
+    BenchArm arm(transport, motor_count, false);
+    auto frames = make_state_frames<can_frame>(motor_count);
+    for (auto& frame : frames) frame.can_dlc = 8;
+    auto& collection = arm.get_device_collection();
+    for (auto _ : state) {
+        for (auto& frame : frames) collection.dispatch_frame_callback(frame);
+    }
+    state.SetItemsProcessed(state.iterations() * motor_count);
+}
+BENCHMARK(BM_DispatchCANFrame)->Arg(1)->Arg(8)->Arg(16);
+
+void BM_DispatchCANFDFrame(benchmark::State& state) {
+    const int motor_count = state.range(0);
+    openarm::canbus::LoopbackTransport transport(true);
+    BenchArm arm(transport, motor_count, true);
+    auto frames = make_state_frames<canfd_frame>(motor_count);
+    for (auto& frame : frames) frame.len = 8;
+    auto& collection = arm.get_device_collection();
+    for (auto _ : state) {
+        for (auto& frame : frames) collection.dispatch_frame_callback(frame);
+    }
+    state.SetItemsProcessed(state.iterations() * motor_count);
+}
+BENCHMARK(BM_DispatchCANFDFrame)->Arg(1)->Arg(8)->Arg(16);
+
+void BM_GetDMDevices(benchmark::State& state) {
+    openarm::canbus::LoopbackTransport transport;
+    BenchArm arm(transport, state.range(0), false);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arm.get_dm_devices());
+    }
+}
+BENCHMARK(BM_GetDMDevices)->Arg(8);
+
+void BM_GetMotors(benchmark::State& state) {
+    openarm::canbus::LoopbackTransport transport;
+    BenchArm arm(transport, state.range(0), false);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arm.get_motors());
+    }
+}
+BENCHMARK(BM_GetMotors)->Arg(8);
+
+}  // namespace
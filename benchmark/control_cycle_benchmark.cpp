@@ -0,0 +1,105 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/can_socket.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/damiao_motor/dm_motor_simulator.hpp>
+#include <vector>
+
+namespace {
+
+using openarm::damiao_motor::MotorType;
+
+constexpr int kMotorCount = 8;
+
+void init_arm(openarm::can::socket::OpenArm& openarm) {
+    std::vector<MotorType> motor_types(kMotorCount, MotorType::DM4310);
+    std::vector<uint32_t> send_can_ids;
+    std::vector<uint32_t> recv_can_ids;
+    for (uint32_t i = 1; i <= kMotorCount; ++i) {
+        send_can_ids.push_back(i);
+        recv_can_ids.push_back(i + 0x10);
+    }
+    openarm.init_arm_motors(motor_types, send_can_ids, recv_can_ids);
+    openarm.set_callback_mode_all(openarm::damiao_motor::CallbackMode::STATE);
+}
+
+void add_simulated_motors(openarm::damiao_motor::DMMotorSimulator& simulator) {
+    for (uint32_t i = 1; i <= kMotorCount; ++i) {
+        simulator.add_motor(MotorType::DM4310, i, i + 0x10);
+    }
+}
+
+// One mit_control_all + recv_all cycle against simulated motors that reply
+// inline, so the measurement covers the library only.
+void BM_MITCycleLoopback(benchmark::State& state) {
+    const bool use_fd = state.range(0) != 0;
+    auto host = std::make_unique<openarm::canbus::LoopbackTransport>(use_fd);
+    openarm::canbus::LoopbackTransport motor_side(use_fd);
+    openarm::canbus::LoopbackTransport::connect(*host, motor_side);
+    openarm::damiao_motor::DMMotorSimulator simulator(motor_side);
+    add_simulated_motors(simulator);
+    host->set_tx_handler([&simulator](const canfd_frame& frame, bool is_fd) {
+        simulator.handle_frame(frame, is_fd);
+    });
+
+    openarm::can::socket::OpenArm openarm(std::move(host));
+    init_arm(openarm);
+    openarm.enable_all();
+    openarm.recv_all(1000);
+
+    std::vector<openarm::damiao_motor::MITParam> params(kMotorCount, {30, 1, 0.5, 0, 0});
+    for (auto _ : state) {
+        openarm.get_arm().mit_control_all(params);
+        openarm.recv_all(1000);
+    }
+    state.SetItemsProcessed(state.iterations() * kMotorCount);
+}
+BENCHMARK(BM_MITCycleLoopback)->Arg(0)->Arg(1)->ArgName("fd");
+
+// Same cycle through the kernel. Needs a vcan0 interface; skipped otherwise.
+void BM_MITCycleVCAN(benchmark::State& state) {
+    const bool use_fd = state.range(0) != 0;
+    std::unique_ptr<openarm::canbus::CANSocket> motor_side;
+    std::unique_ptr<openarm::can::socket::OpenArm> openarm;
+    try {
+        motor_side = std::make_unique<openarm::canbus::CANSocket>("vcan0", use_fd);
+        openarm = std::make_unique<openarm::can::socket::OpenArm>("vcan0", use_fd);
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+    openarm::damiao_motor::DMMotorSimulator simulator(*motor_side);
+    add_simulated_motors(simulator);
+    simulator.start();
+
+    init_arm(*openarm);
+    openarm->enable_all();
+    openarm->recv_all(10000);
+
+    std::vector<openarm::damiao_motor::MITParam> params(kMotorCount, {30, 1, 0.5, 0, 0});
+    for (auto _ : state) {
+        openarm->get_arm().mit_control_all(params);
+        openarm->recv_all(10000);
+    }
+    simulator.stop();
+    state.SetItemsProcessed(state.iterations() * kMotorCount);
+}
+BENCHMARK(BM_MITCycleVCAN)->Arg(0)->Arg(1)->ArgName("fd")->UseRealTime();
+
+}  // namespace
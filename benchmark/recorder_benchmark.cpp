@@ -0,0 +1,49 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <openarm/canbus/frame_recorder.hpp>
+
+namespace {
+
+using openarm::canbus::FrameDirection;
+using openarm::canbus::FrameRecorder;
+using openarm::canbus::FrameRecorderOptions;
+
+// Hot path cost of recording one frame. The ring is drained outside the
+// timed region so the frames are queued rather than dropped.
+void BM_FrameRecorderRecord(benchmark::State& state) {
+    FrameRecorderOptions options;
+    options.binary_path = "/dev/null";
+    options.text_path = "/dev/null";
+    FrameRecorder recorder("bench", options);
+    canfd_frame frame{};
+    frame.can_id = 0x011;
+    frame.len = 8;
+    size_t batch = 0;
+    for (auto _ : state) {
+        recorder.record(FrameDirection::RX, frame);
+        if (++batch == options.ring_capacity / 2) {
+            state.PauseTiming();
+            recorder.flush();
+            batch = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.counters["dropped"] = static_cast<double>(recorder.get_dropped());
+}
+BENCHMARK(BM_FrameRecorderRecord);
+
+}  // namespace
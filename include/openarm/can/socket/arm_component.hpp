@@ -16,7 +16,7 @@
 
 #include <vector>
 
-#include "../../canbus/can_socket.hpp"
+#include "../../canbus/can_transport.hpp"
 #include "../../damiao_motor/dm_motor.hpp"
 #include "../../damiao_motor/dm_motor_device_collection.hpp"
 
@@ -24,7 +24,7 @@ namespace openarm::can::socket {
 
 class ArmComponent : public damiao_motor::DMDeviceCollection {
 public:
-    ArmComponent(canbus::CANSocket& can_socket);
+    ArmComponent(canbus::CANTransport& transport);
     ~ArmComponent() = default;
 
     void init_motor_devices(const std::vector<damiao_motor::MotorType>& motor_types,
@@ -24,7 +24,7 @@ namespace openarm::can::socket {
 
 class GripperComponent : public damiao_motor::DMDeviceCollection {
 public:
-    GripperComponent(canbus::CANSocket& can_socket);
+    GripperComponent(canbus::CANTransport& transport);
     ~GripperComponent() = default;
 
     void init_motor_device(damiao_motor::MotorType motor_type, uint32_t send_can_id,
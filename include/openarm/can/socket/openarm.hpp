@@ -14,19 +14,56 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../../canbus/can_device_collection.hpp"
+#include "../../canbus/can_error.hpp"
+#include "../../canbus/can_netlink.hpp"
 #include "../../canbus/can_socket.hpp"
+#include "../../canbus/can_transport.hpp"
+#include "../../canbus/can_tx_scheduler.hpp"
+#include "../../canbus/cycle_stats.hpp"
+#include "../../canbus/frame_recorder.hpp"
+#include "../../canbus/log.hpp"
 #include "arm_component.hpp"
 #include "gripper_component.hpp"
 
 namespace openarm::can::socket {
+
+struct EStopResult {
+    int frames_queued = 0;
+    // Refused by the socket. They stay pending in the TX scheduler and go out
+    // ahead of all other traffic on the next recv_all() or flush_tx().
+    int frames_failed = 0;
+    // Not written because the transport is not async-signal-safe (see
+    // estop_all()). They go out like failed frames.
+    int frames_deferred = 0;
+    // Time from the estop call until the last frame was queued in the kernel
+    int64_t latency_ns = 0;
+};
+
+// What OpenArm does when the CAN controller goes bus-off
+enum class BusOffRecovery {
+    NONE,     // report only; the interface may restart itself (restart-ms)
+    RESTART,  // restart the controller over rtnetlink; needs CAP_NET_ADMIN
+};
+
 class OpenArm {
 public:
-    OpenArm(const std::string& can_interface, bool enable_fd = false);
-    ~OpenArm() = default;
+    OpenArm(const std::string& can_interface, bool enable_fd = false,
+            const canbus::CANSocketOptions& socket_options = canbus::CANSocketOptions());
+    // Run on any transport, e.g. canbus::LoopbackTransport for tests
+    explicit OpenArm(std::unique_ptr<canbus::CANTransport> transport);
+    ~OpenArm();
+
+    // Registered for process-wide emergency stop, so the address must not change
+    OpenArm(const OpenArm&) = delete;
+    OpenArm& operator=(const OpenArm&) = delete;
 
     std::string can_interface() const noexcept { return can_interface_; }
     bool can_fd_enabled() const noexcept { return enable_fd_; }
@@ -47,30 +84,96 @@ public:
     canbus::CANDeviceCollection& get_master_can_device_collection() {
         return *master_can_device_collection_;
     }
+    canbus::CANTransport& get_transport() { return *transport_; }
+    // All arm and gripper frames go through this priority scheduler
+    canbus::CANTxScheduler& get_tx_scheduler() { return *tx_scheduler_; }
 
     // Damiao Motor operations (works only on sub_dm_device_collections_)
     void enable_all();
     void disable_all();
+    void clear_error_all();
     void set_zero_all();
     void refresh_all();
 
     void refresh_one(int i);
+
+    // Emergency stop: queue the prebuilt disable frame of every registered
+    // motor with batched writes, and discard enable and control frames the
+    // TX scheduler still holds. Safe to call from a watchdog thread once
+    // motors are initialized. It is async-signal-safe only when the
+    // transport is (see CANTransport::is_async_signal_safe(), true for
+    // CANSocket); LoopbackTransport and FaultInjectionTransport lock.
+    EStopResult estop() noexcept;
+    // Emergency stop every OpenArm instance alive in this process. Does not
+    // allocate or lock, so it can be called from a signal handler: instances
+    // on a transport that is not async-signal-safe only get their queued
+    // frames discarded, and their disables are deferred to the next
+    // recv_all() or flush_tx(). Up to kMaxEStopInstances are reachable; the
+    // destructor waits only for estop_all() calls that are using the
+    // instance.
+    static EStopResult estop_all() noexcept;
+    static constexpr size_t kMaxEStopInstances = 32;
+    int64_t get_estop_max_latency_ns() const noexcept {
+        return estop_max_latency_ns_.load(std::memory_order_relaxed);
+    }
+
     // The timeout for reading the first response from socket, set to
     // timeout_us. Tuning this value may improve the performance but
     // should be done with caution.
     void recv_all(int first_timeout_us = 500);
+    // Retry frames held back by socket backpressure. recv_all() does this too.
+    size_t flush_tx();
+    // Time spent per phase of each command/reply cycle. Commands sent since
+    // the last recv_all() and the replies it reads make up one cycle.
+    const canbus::CycleStats& get_cycle_stats() const { return cycle_stats_; }
+    void reset_cycle_stats() { cycle_stats_.reset(); }
     void set_callback_mode_all(damiao_motor::CallbackMode callback_mode);
+    void set_fault_callback_all(const damiao_motor::FaultCallback& fault_callback);
     void query_param_all(int RID);
 
+    // Called from recv_all() for every error frame on the bus
+    void set_bus_error_callback(canbus::CANErrorCallback callback) {
+        bus_error_callback_ = std::move(callback);
+    }
+    canbus::CANBusState get_bus_state() { return transport_->get_error_monitor().get_state(); }
+    // Restarts are requested at most every kBusOffRestartIntervalNs and run
+    // on a background thread, so recv_all() never waits for rtnetlink
+    void set_bus_off_recovery(BusOffRecovery recovery);
+    // Restarts that completed
+    uint64_t get_bus_off_restarts() const { return restarter_ ? restarter_->get_restarts() : 0; }
+    static constexpr int64_t kBusOffRestartIntervalNs = 100000000;
+
+    // Record written and received frames. Pass nullptr to stop recording.
+    void set_frame_recorder(canbus::FrameRecorder* frame_recorder);
+
 private:
     std::string can_interface_;
     bool enable_fd_;
-    std::unique_ptr<canbus::CANSocket> can_socket_;
+    std::unique_ptr<canbus::CANTransport> transport_;
+    std::unique_ptr<canbus::CANTxScheduler> tx_scheduler_;
     std::unique_ptr<ArmComponent> arm_;
     std::unique_ptr<GripperComponent> gripper_;
     std::unique_ptr<canbus::CANDeviceCollection> master_can_device_collection_;
     std::vector<damiao_motor::DMDeviceCollection*> sub_dm_device_collections_;
+    // Disable frames for every registered motor, used as the TX scheduler's
+    // stop frames. Registration publishes a new set; older sets stay alive
+    // until destruction because estop() may still be reading them.
+    std::vector<std::unique_ptr<canbus::TxStopFrames>> estop_frame_sets_;
+    std::atomic<int64_t> estop_max_latency_ns_{0};
+    canbus::CycleStats cycle_stats_;
+    canbus::CANErrorCallback bus_error_callback_;
+    BusOffRecovery bus_off_recovery_ = BusOffRecovery::NONE;
+    std::unique_ptr<canbus::CANInterfaceRestarter> restarter_;
+    int64_t last_restart_ns_ = 0;
+    // Per instance, so one interface's messages never hide another's
+    canbus::LogThrottle bus_off_log_throttle_;
+    canbus::LogThrottle error_passive_log_throttle_;
     void register_dm_device_collection(damiao_motor::DMDeviceCollection& device_collection);
+    // Write the disables, or only mark them pending when defer_unsafe is set
+    // and the transport is not async-signal-safe
+    EStopResult write_estop_frames(bool defer_unsafe) noexcept;
+    void record_estop_latency(int64_t latency_ns) noexcept;
+    void handle_bus_error(const canbus::CANErrorEvent& event);
 };
 
 }  // namespace openarm::can::socket
@@ -0,0 +1,95 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace openarm::canbus {
+
+// Fixed-capacity lock-free queue for many producers and one consumer.
+// Producers never block: try_push() fails when the queue is full. Elements
+// are filled and consumed in place, so T needs no copy or move support.
+template <typename T>
+class BoundedQueue {
+public:
+    // capacity is rounded up to a power of two, at least 2
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask_ = size - 1;
+        slots_.reset(new Slot[size]);
+        for (size_t i = 0; i < size; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Claim a slot and call fill(T&) on it. Safe from any thread.
+    template <typename Fill>
+    bool try_push(Fill&& fill) noexcept {
+        // Each slot's sequence tells whether it is free for the position a
+        // producer claimed (Vyukov's bounded queue)
+        size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots_[position & mask_];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t difference =
+                static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+        fill(slot->value);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Call consume(T&) on the oldest element. Only one thread may pop.
+    template <typename Consume>
+    bool try_pop(Consume&& consume) {
+        Slot& slot = slots_[dequeue_position_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) return false;
+        consume(slot.value);
+        slot.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_position_;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    std::atomic<size_t> enqueue_position_{0};
+    size_t dequeue_position_ = 0;
+};
+
+}  // namespace openarm::canbus
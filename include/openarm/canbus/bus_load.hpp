@@ -0,0 +1,68 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "metrics.hpp"
+
+namespace openarm::canbus {
+
+// Nominal and CAN FD data phase bitrates, as set by can_configure
+struct BusTiming {
+    uint32_t bitrate = 1000000;
+    uint32_t data_bitrate = 5000000;
+};
+
+// Time a frame occupies the bus, including worst-case bit stuffing and the
+// interframe space. CAN FD frames with CANFD_BRS send the data phase at
+// data_bitrate. Worst case keeps the estimate an upper bound.
+uint64_t frame_duration_ns(const can_frame& frame, const BusTiming& timing);
+uint64_t frame_duration_ns(const canfd_frame& frame, const BusTiming& timing);
+
+// Fraction of bus time used by the frames seen on one interface, averaged
+// over fixed intervals. Recording is lock free and async-signal-safe.
+class BusLoadEstimator {
+public:
+    explicit BusLoadEstimator(const BusTiming& timing, Gauge* gauge = nullptr,
+                              int64_t interval_ns = 1000000000);
+
+    void record(const can_frame* frames, size_t count) noexcept;
+    void record(const canfd_frame* frames, size_t count) noexcept;
+    // Close the interval if it has run its length. record() does this too;
+    // call it while the bus is idle to let the load fall.
+    void update() noexcept;
+
+    // Load over the last completed interval. Above 1.0 means more frames
+    // were queued than the bus can carry.
+    double get_load() const { return load_.load(std::memory_order_relaxed); }
+    const BusTiming& get_timing() const { return timing_; }
+
+private:
+    void add(uint64_t busy_ns) noexcept;
+
+    BusTiming timing_;
+    Gauge* gauge_;
+    int64_t interval_ns_;
+    std::atomic<uint64_t> busy_ns_{0};
+    std::atomic<int64_t> interval_start_ns_;
+    std::atomic<double> load_{0.0};
+};
+
+}  // namespace openarm::canbus
@@ -16,10 +16,14 @@
 
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <time.h>
 
 #include <cstdint>
 #include <vector>
 
+#include "latency_histogram.hpp"
+#include "metrics.hpp"
+
 namespace openarm::canbus {
 // Abstract base class for CAN devices
 class CANDevice {
@@ -40,11 +44,99 @@ public:
     canid_t get_recv_can_mask() const { return recv_can_mask_; }
     bool is_fd_enabled() const { return is_fd_enabled_; }
 
+    // TX accounting, updated by whoever writes frames for this device once a
+    // frame is written or given up on, never when it is merely queued. A
+    // successful write starts a round trip that the next received frame ends.
+    void record_tx(bool success) {
+        if (success) {
+            ++tx_frames_;
+            if (metrics_.tx_frames) metrics_.tx_frames->inc();
+            last_tx_ns_ = monotonic_now_ns();
+        } else {
+            ++tx_failures_;
+            if (metrics_.tx_failures) metrics_.tx_failures->inc();
+        }
+    }
+    uint64_t get_tx_frames() const { return tx_frames_; }
+    uint64_t get_tx_failures() const { return tx_failures_; }
+    // RX accounting, updated by CANDeviceCollection on dispatch
+    void record_rx() {
+        ++rx_frames_;
+        if (metrics_.rx_frames) metrics_.rx_frames->inc();
+        if (last_tx_ns_ != 0) {
+            rtt_histogram_.record(monotonic_now_ns() - last_tx_ns_);
+            last_tx_ns_ = 0;
+        }
+    }
+    uint64_t get_rx_frames() const { return rx_frames_; }
+    // Received frames the device could not parse
+    void record_decode_error() {
+        ++decode_errors_;
+        if (metrics_.decode_errors) metrics_.decode_errors->inc();
+    }
+    uint64_t get_decode_errors() const { return decode_errors_; }
+    // Commands refused before sending, e.g. for the wrong control mode
+    void record_rejected_command() {
+        ++rejected_commands_;
+        if (metrics_.rejected_commands) metrics_.rejected_commands->inc();
+    }
+    uint64_t get_rejected_commands() const { return rejected_commands_; }
+
+    // Mirror the counters above into registry series with the given labels.
+    // The first call wins; counts so far are carried over.
+    void bind_metrics(MetricsRegistry& registry, const MetricLabels& labels) {
+        if (metrics_.tx_frames) return;
+        metrics_.tx_frames = &registry.counter("openarm_can_device_tx_frames_total",
+                                               "Frames written for the device", labels);
+        metrics_.tx_failures = &registry.counter("openarm_can_device_tx_failures_total",
+                                                 "Frames that were never written", labels);
+        metrics_.rx_frames = &registry.counter("openarm_can_device_rx_frames_total",
+                                               "Frames dispatched to the device", labels);
+        metrics_.decode_errors = &registry.counter("openarm_can_device_decode_errors_total",
+                                                   "Received frames that failed to decode",
+                                                   labels);
+        metrics_.rejected_commands = &registry.counter(
+            "openarm_can_device_rejected_commands_total", "Commands refused before sending",
+            labels);
+        metrics_.tx_frames->inc(tx_frames_);
+        metrics_.tx_failures->inc(tx_failures_);
+        metrics_.rx_frames->inc(rx_frames_);
+        metrics_.decode_errors->inc(decode_errors_);
+        metrics_.rejected_commands->inc(rejected_commands_);
+    }
+
+    // Time from command write to the matching reply
+    const LatencyHistogram& get_rtt_histogram() const { return rtt_histogram_; }
+    void reset_rtt_histogram() { rtt_histogram_.reset(); }
+
 protected:
     canid_t send_can_id_;
     canid_t recv_can_id_;
     // mask for receiving
     canid_t recv_can_mask_ = CAN_SFF_MASK;
     bool is_fd_enabled_ = false;
+    uint64_t tx_frames_ = 0;
+    uint64_t tx_failures_ = 0;
+    uint64_t rx_frames_ = 0;
+    uint64_t decode_errors_ = 0;
+    uint64_t rejected_commands_ = 0;
+    uint64_t last_tx_ns_ = 0;  // 0 while no round trip is open
+    LatencyHistogram rtt_histogram_;
+
+private:
+    struct BoundMetrics {
+        Counter* tx_frames = nullptr;
+        Counter* tx_failures = nullptr;
+        Counter* rx_frames = nullptr;
+        Counter* decode_errors = nullptr;
+        Counter* rejected_commands = nullptr;
+    };
+    BoundMetrics metrics_;
+
+    static uint64_t monotonic_now_ns() {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+    }
 };
 }  // namespace openarm::canbus
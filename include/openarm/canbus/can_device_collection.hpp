@@ -21,11 +21,14 @@
 
 #include "can_device.hpp"
 #include "can_socket.hpp"
+#include "can_transport.hpp"
+#include "frame_recorder.hpp"
+#include "metrics.hpp"
 
 namespace openarm::canbus {
 class CANDeviceCollection {
 public:
-    CANDeviceCollection(canbus::CANSocket& can_socket);
+    CANDeviceCollection(canbus::CANTransport& transport);
     ~CANDeviceCollection();
 
     void add_device(const std::shared_ptr<CANDevice>& device);
@@ -33,11 +36,20 @@ public:
     void dispatch_frame_callback(can_frame& frame);
     void dispatch_frame_callback(canfd_frame& frame);
     const std::map<canid_t, std::shared_ptr<CANDevice>>& get_devices() const { return devices_; }
-    canbus::CANSocket& get_can_socket() const { return can_socket_; }
-    int get_socket_fd() const { return can_socket_.get_socket_fd(); }
+    canbus::CANTransport& get_transport() const { return transport_; }
+    // Throws std::bad_cast when the collection runs on another transport
+    [[deprecated("use get_transport()")]] canbus::CANSocket& get_can_socket() const {
+        return dynamic_cast<canbus::CANSocket&>(transport_);
+    }
+    int get_socket_fd() const { return transport_.get_socket_fd(); }
+    uint64_t get_unknown_id_frames() const { return unknown_id_frames_.value(); }
+    // Record every dispatched frame, including ones for unknown devices
+    void set_frame_recorder(FrameRecorder* frame_recorder) { frame_recorder_ = frame_recorder; }
 
 private:
-    canbus::CANSocket& can_socket_;
+    canbus::CANTransport& transport_;
     std::map<canid_t, std::shared_ptr<CANDevice>> devices_;
+    Counter& unknown_id_frames_;
+    FrameRecorder* frame_recorder_ = nullptr;
 };
 }  // namespace openarm::canbus
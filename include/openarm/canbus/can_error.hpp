@@ -0,0 +1,110 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "metrics.hpp"
+
+namespace openarm::canbus {
+
+// Fault confinement state of the CAN controller, in the order of the
+// kernel's enum can_state. Error frames never report STOPPED; it comes from
+// the interface state over rtnetlink.
+enum class CANBusState : uint8_t { ERROR_ACTIVE, ERROR_WARNING, ERROR_PASSIVE, BUS_OFF, STOPPED };
+
+const char* to_string(CANBusState state);
+
+// Error classes of linux/can/error.h; class i is the CAN_ERR_* bit 1 << i
+enum class CANErrorClass : uint8_t {
+    TX_TIMEOUT,
+    LOST_ARBITRATION,
+    CONTROLLER,
+    PROTOCOL,
+    TRANSCEIVER,
+    NO_ACK,
+    BUS_OFF,
+    BUS_ERROR,
+    RESTARTED,
+    COUNT,
+};
+
+const char* to_string(CANErrorClass error_class);
+
+// One decoded error frame
+struct CANErrorEvent {
+    // CAN_ERR_* class bits of the frame
+    canid_t classes = 0;
+    // Controller state after this frame
+    CANBusState state = CANBusState::ERROR_ACTIVE;
+    // Controller RX/TX buffer overflows, reported with CONTROLLER
+    bool rx_overflow = false;
+    bool tx_overflow = false;
+    // Error counters, if the driver reports them
+    bool has_error_counters = false;
+    uint8_t tx_error_counter = 0;
+    uint8_t rx_error_counter = 0;
+
+    bool has(CANErrorClass error_class) const {
+        return classes & (1u << static_cast<unsigned>(error_class));
+    }
+};
+
+// Decode an error frame (CAN_ERR_FLAG set). The state carries over from
+// previous_state unless the frame reports a change.
+CANErrorEvent decode_error_frame(const can_frame& frame, CANBusState previous_state);
+
+using CANErrorCallback = std::function<void(const CANErrorEvent& event)>;
+
+// Decodes the error frames of one interface, counts them per class and
+// tracks the controller state. Transports feed it every error frame they
+// receive instead of returning the frame from a read. Not thread safe; use
+// it from the thread that reads the transport.
+class CANErrorMonitor {
+public:
+    // Returns false if frame is not an error frame
+    bool process(const can_frame& frame);
+
+    // Called on the reading thread for every error frame
+    void set_callback(CANErrorCallback callback) { callback_ = std::move(callback); }
+
+    CANBusState get_state() const { return state_; }
+    uint64_t get_error_frames() const { return error_frames_; }
+    uint64_t get_error_count(CANErrorClass error_class) const {
+        return class_counts_[static_cast<size_t>(error_class)];
+    }
+
+    // Mirror the counts into openarm_can_bus_error_frames_total{class=...}
+    // and the state into openarm_can_bus_state. The first call wins.
+    void bind_metrics(MetricsRegistry& registry, const MetricLabels& labels);
+
+private:
+    static constexpr size_t kClassCount = static_cast<size_t>(CANErrorClass::COUNT);
+
+    CANBusState state_ = CANBusState::ERROR_ACTIVE;
+    uint64_t error_frames_ = 0;
+    std::array<uint64_t, kClassCount> class_counts_{};
+    std::array<Counter*, kClassCount> class_metrics_{};
+    Gauge* state_metric_ = nullptr;
+    CANErrorCallback callback_;
+};
+
+}  // namespace openarm::canbus
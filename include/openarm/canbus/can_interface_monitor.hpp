@@ -0,0 +1,81 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "can_netlink.hpp"
+#include "metrics.hpp"
+
+namespace openarm::canbus {
+
+// Polls the kernel's view of CAN interfaces over rtnetlink from a background
+// thread and mirrors it into the registry next to the library's own bus
+// metrics: openarm_can_interface_state, the error counters as gauges and
+// the controller and link statistics as *_total counters.
+class CANInterfaceMonitor {
+public:
+    CANInterfaceMonitor(const std::vector<std::string>& interfaces,
+                        MetricsRegistry& registry = MetricsRegistry::global(),
+                        int interval_ms = 1000);
+    ~CANInterfaceMonitor();
+
+    CANInterfaceMonitor(const CANInterfaceMonitor&) = delete;
+    CANInterfaceMonitor& operator=(const CANInterfaceMonitor&) = delete;
+
+    // Poll all interfaces now instead of waiting for the thread
+    void poll();
+
+    // Latest status of interfaces[index]; false until it was read once
+    bool get_status(size_t index, CANInterfaceStatus& status) const;
+    // Failed status queries, e.g. for an interface that went away
+    uint64_t get_poll_failures() const { return poll_failures_.load(); }
+
+private:
+    static constexpr size_t kCounterCount = 11;
+
+    struct Interface {
+        std::string name;
+        bool valid = false;
+        CANInterfaceStatus status;
+        Gauge* state;
+        Gauge* tx_error_counter;
+        Gauge* rx_error_counter;
+        std::array<Counter*, kCounterCount> counters;
+        std::array<uint64_t, kCounterCount> last_values{};
+    };
+
+    void run();
+    void publish(Interface& interface, const CANInterfaceStatus& status);
+
+    int interval_ms_;
+    std::vector<Interface> interfaces_;
+    mutable std::mutex status_mutex_;
+    std::mutex poll_mutex_;
+    std::atomic<uint64_t> poll_failures_{0};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+}  // namespace openarm::canbus
@@ -0,0 +1,136 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "can_error.hpp"
+
+namespace openarm::canbus {
+
+// rtnetlink request failure; error_code() is the errno the kernel returned
+class CANNetlinkException : public std::runtime_error {
+public:
+    CANNetlinkException(const std::string& message, int error_code);
+    int error_code() const { return error_code_; }
+
+private:
+    int error_code_;
+};
+
+// Link state and counters of one interface as reported by RTM_GETLINK. The
+// CAN fields are only filled in for CAN devices (is_can).
+struct CANInterfaceStatus {
+    bool up = false;       // administratively up
+    bool running = false;  // up with the carrier on
+    bool is_can = false;
+
+    CANBusState state = CANBusState::STOPPED;
+    bool has_error_counters = false;
+    uint16_t tx_error_counter = 0;
+    uint16_t rx_error_counter = 0;
+    uint32_t bitrate = 0;
+    uint32_t sample_point = 0;  // in tenths of a percent
+    uint32_t data_bitrate = 0;
+    uint32_t restart_ms = 0;  // 0 disables automatic bus-off recovery
+
+    // Controller events since the interface was created (can_device_stats)
+    uint32_t bus_errors = 0;
+    uint32_t error_warning = 0;
+    uint32_t error_passive = 0;
+    uint32_t bus_off = 0;
+    uint32_t arbitration_lost = 0;
+    uint32_t restarts = 0;
+
+    // Generic link statistics (rtnl_link_stats64)
+    uint64_t rx_packets = 0;
+    uint64_t tx_packets = 0;
+    uint64_t rx_errors = 0;
+    uint64_t tx_errors = 0;
+    uint64_t rx_dropped = 0;
+    uint64_t tx_dropped = 0;
+    uint64_t rx_over_errors = 0;
+};
+
+// Query the state of an interface. Needs no privileges. Throws
+// CANNetlinkException, e.g. with ENODEV for an unknown interface.
+CANInterfaceStatus read_can_interface_status(const std::string& interface);
+
+// Bit timing and controller options applied by configure_can_interface().
+// The defaults match `openarm-can-cli can_configure`.
+struct CANInterfaceConfig {
+    uint32_t bitrate = 1000000;
+    uint32_t sample_point = 750;  // in tenths of a percent, 0 for the kernel's choice
+    uint32_t sjw = 0;             // 0 for the kernel's choice
+    bool fd = true;
+    uint32_t data_bitrate = 5000000;  // data phase, only used with fd
+    uint32_t data_sample_point = 750;
+    uint32_t data_sjw = 2;
+    uint32_t restart_ms = 100;  // 0 disables automatic bus-off recovery
+    bool up = true;             // bring the interface up afterwards
+};
+
+// Take the interface down, apply config and bring it back up, like `ip link
+// set <interface> type can bitrate ...` between `down` and `up`. Requires
+// CAP_NET_ADMIN. Throws CANNetlinkException with the kernel's reason, e.g.
+// EINVAL for a bitrate the controller cannot reach.
+void configure_can_interface(const std::string& interface, const CANInterfaceConfig& config);
+
+// Bring an interface up or down. Requires CAP_NET_ADMIN.
+void set_can_interface_up(const std::string& interface, bool up);
+
+// Restart a bus-off CAN controller, like `ip link set <interface> type can
+// restart`. Requires CAP_NET_ADMIN. The kernel refuses with EBUSY while the
+// controller is not bus-off.
+void restart_can_interface(const std::string& interface);
+
+// Runs restart_can_interface() on a background thread so that the control
+// loop never blocks on rtnetlink. Requests made while one is pending merge;
+// failures are logged and counted.
+class CANInterfaceRestarter {
+public:
+    explicit CANInterfaceRestarter(const std::string& interface);
+    // Waits for a restart in progress
+    ~CANInterfaceRestarter();
+
+    CANInterfaceRestarter(const CANInterfaceRestarter&) = delete;
+    CANInterfaceRestarter& operator=(const CANInterfaceRestarter&) = delete;
+
+    // Returns false if a restart is already pending
+    bool request_restart();
+
+    uint64_t get_restarts() const { return restarts_.load(); }
+    uint64_t get_failures() const { return failures_.load(); }
+
+private:
+    void run();
+
+    std::string interface_;
+    std::atomic<uint64_t> restarts_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool requested_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+}  // namespace openarm::canbus
@@ -16,10 +16,18 @@
 
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <sys/socket.h>
 
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
+#include "bus_load.hpp"
+#include "can_transport.hpp"
+#include "frame_recorder.hpp"
+#include "metrics.hpp"
+
 namespace openarm::canbus {
 
 // Exception classes for socket operations
@@ -29,11 +37,27 @@ public:
         : std::runtime_error("Socket error: " + message) {}
 };
 
-// Base socket management class
-class CANSocket {
+struct CANSocketOptions {
+    // SO_SNDBUF/SO_RCVBUF in bytes; 0 keeps the kernel default. The send
+    // buffer bounds how many frames may wait in the socket before writes
+    // fail with ENOBUFS.
+    int send_buffer_size = 0;
+    int receive_buffer_size = 0;
+    // Enable SO_RXQ_OVFL to count frames the kernel dropped on receive
+    bool track_rx_overflow = true;
+    // Subscribe to error frames (CAN_RAW_ERR_FILTER) and feed them to the
+    // error monitor
+    bool receive_error_frames = true;
+    // Bitrates the interface is configured with, for the bus load estimate
+    BusTiming bus_timing;
+};
+
+// SocketCAN raw socket transport
+class CANSocket : public CANTransport {
 public:
-    explicit CANSocket(const std::string& interface, bool enable_fd = false);
-    ~CANSocket();
+    explicit CANSocket(const std::string& interface, bool enable_fd = false,
+                       const CANSocketOptions& options = CANSocketOptions());
+    ~CANSocket() override;
 
     // Disable copy, enable move
     CANSocket(const CANSocket&) = delete;
@@ -42,9 +66,11 @@ public:
     CANSocket& operator=(CANSocket&&) = default;
 
     // File descriptor access for Python bindings
-    int get_socket_fd() const { return socket_fd_; }
-    const std::string& get_interface() const { return interface_; }
-    bool is_canfd_enabled() const { return fd_enabled_; }
+    int get_socket_fd() const override { return socket_fd_; }
+    const std::string& get_interface() const override { return interface_; }
+    bool is_canfd_enabled() const override { return fd_enabled_; }
+    // Writes are sendmmsg() on stack buffers plus lock-free bookkeeping
+    bool is_async_signal_safe() const override { return true; }
     bool is_initialized() const { return socket_fd_ >= 0; }
 
     // Direct frame operations for Python bindings
@@ -52,23 +78,57 @@ public:
     ssize_t write_raw_frame(const void* buffer, size_t frame_size);
 
     // write can_frame or canfd_frame
-    bool write_can_frame(const can_frame& frame);
-    bool write_canfd_frame(const canfd_frame& frame);
+    bool write_can_frame(const can_frame& frame) override;
+    bool write_canfd_frame(const canfd_frame& frame) override;
+
+    // Batched writes with sendmmsg(2). Returns the number of frames queued,
+    // stopping at the first failure. Allocation free and safe to call from a
+    // signal handler.
+    int write_can_frames(const can_frame* frames, size_t count) override;
+    int write_canfd_frames(const canfd_frame* frames, size_t count) override;
 
     // read can_frame or canfd_frame
-    bool read_can_frame(can_frame& frame);
-    bool read_canfd_frame(canfd_frame& frame);
+    bool read_can_frame(can_frame& frame) override;
+    bool read_canfd_frame(canfd_frame& frame) override;
+
+    // Batched non-blocking reads with recvmmsg(2)
+    int read_can_frames(can_frame* frames, size_t count) override;
+    int read_canfd_frames(canfd_frame* frames, size_t count) override;
 
     // check if data is available for reading (non-blocking)
-    bool is_data_available(int timeout_us = 100);
+    bool is_data_available(int timeout_us = 100) override;
+
+    // Frames dropped by the kernel because the receive queue was full, as
+    // reported by SO_RXQ_OVFL with the latest received frame.
+    uint32_t get_rx_overflow_count() const { return rx_overflow_count_; }
+
+    // Estimated fraction of bus time used by the frames this socket wrote
+    // and read over the last second. Frames filtered out or never read are
+    // not seen, so the estimate is a lower bound on a shared bus.
+    double get_bus_load() const { return bus_load_->get_load(); }
 
 protected:
+    int write_frames(const void* frames, size_t frame_size, size_t count);
+    ssize_t receive_frame(void* frame, size_t frame_size);
+    int read_frames(void* frames, size_t frame_size, size_t count);
+    void update_rx_overflow_count(msghdr& msg);
+    void record_raw_bus_load(const void* buffer, ssize_t size);
+    bool consume_error_frame(const void* frame, size_t size);
     bool initialize_socket(const std::string& interface);
     void cleanup();
 
     int socket_fd_;
     std::string interface_;
     bool fd_enabled_;
+    CANSocketOptions options_;
+    uint32_t rx_overflow_count_ = 0;
+
+    // Per-interface series in MetricsRegistry::global()
+    Counter* tx_frames_metric_;
+    Counter* tx_errors_metric_;
+    Counter* rx_frames_metric_;
+    Counter* rx_overflow_metric_;
+    std::unique_ptr<BusLoadEstimator> bus_load_;
 };
 
 }  // namespace openarm::canbus
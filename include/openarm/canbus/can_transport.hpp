@@ -0,0 +1,79 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <cstddef>
+#include <string>
+
+#include "can_error.hpp"
+
+namespace openarm::canbus {
+
+class FrameRecorder;
+
+// Abstract frame transport. CANSocket talks to a SocketCAN interface;
+// LoopbackTransport stays in process for tests and benchmarks.
+class CANTransport {
+public:
+    virtual ~CANTransport() = default;
+
+    virtual const std::string& get_interface() const = 0;
+    virtual bool is_canfd_enabled() const = 0;
+    // Descriptor that polls readable while frames are pending, or -1
+    virtual int get_socket_fd() const = 0;
+
+    // Batch operations return the number of frames transferred. Reads never
+    // block; pair them with is_data_available() to wait. Error frames are
+    // consumed without ending a read early, so a read returns 0 only once
+    // nothing readable is left.
+    virtual int write_can_frames(const can_frame* frames, size_t count) = 0;
+    virtual int write_canfd_frames(const canfd_frame* frames, size_t count) = 0;
+    virtual int read_can_frames(can_frame* frames, size_t count) = 0;
+    virtual int read_canfd_frames(canfd_frame* frames, size_t count) = 0;
+
+    // Wait up to timeout_us for a frame to become readable
+    virtual bool is_data_available(int timeout_us = 100) = 0;
+
+    // Whether the batch writes neither lock nor allocate, so they may run in
+    // a signal handler or interrupt another thread inside this transport
+    virtual bool is_async_signal_safe() const { return false; }
+
+    // Single-frame helpers
+    virtual bool write_can_frame(const can_frame& frame) {
+        return write_can_frames(&frame, 1) == 1;
+    }
+    virtual bool write_canfd_frame(const canfd_frame& frame) {
+        return write_canfd_frames(&frame, 1) == 1;
+    }
+    virtual bool read_can_frame(can_frame& frame) { return read_can_frames(&frame, 1) == 1; }
+    virtual bool read_canfd_frame(canfd_frame& frame) { return read_canfd_frames(&frame, 1) == 1; }
+
+    // Record every frame this transport writes. Pass nullptr to stop; the
+    // recorder must outlive its use.
+    void set_frame_recorder(FrameRecorder* frame_recorder) { frame_recorder_ = frame_recorder; }
+    FrameRecorder* get_frame_recorder() const { return frame_recorder_; }
+
+    // Error frames received on the bus are decoded here instead of being
+    // returned by reads. Decorators forward to the transport they wrap.
+    virtual CANErrorMonitor& get_error_monitor() { return error_monitor_; }
+
+protected:
+    FrameRecorder* frame_recorder_ = nullptr;
+    CANErrorMonitor error_monitor_;
+};
+
+}  // namespace openarm::canbus
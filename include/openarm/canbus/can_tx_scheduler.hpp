@@ -0,0 +1,229 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "can_device.hpp"
+#include "can_transport.hpp"
+
+namespace openarm::canbus {
+
+// Priority classes, highest first
+enum class TxPriority : uint8_t { SAFETY = 0, CONTROL = 1, CONFIG = 2, DIAGNOSTICS = 3, COUNT = 4 };
+
+// What happened to a submitted frame by the time submit() returned
+enum class TxOutcome : uint8_t {
+    SENT,     // written to the transport
+    QUEUED,   // held back by backpressure or a higher class; a later flush decides
+    DROPPED,  // refused by a full queue, or discarded on a write error or retry limit
+};
+
+// What a frame does to its device, as far as queueing is concerned
+enum class TxKind : uint8_t {
+    NORMAL,
+    // Puts the device in a safe state, e.g. a motor disable. A full queue
+    // evicts its oldest non-STOP frame to make room for it, and it is never
+    // evicted itself.
+    STOP,
+};
+
+// Which queued frame a newly submitted one may replace. A NORMAL frame
+// never replaces a queued STOP frame.
+enum class TxCoalescing : uint8_t {
+    NONE,
+    // The queued frame for the same CAN ID; setpoints supersede each other
+    BY_CAN_ID,
+    // A queued frame with the same CAN ID and payload, i.e. the same command
+    // to the same device. Different commands to one device all stay queued.
+    BY_FRAME,
+};
+
+// Frames that bring every device on the transport to a safe state, e.g. one
+// disable per motor. Both layouts are kept so either kind of transport can
+// be served.
+struct TxStopFrames {
+    std::vector<can_frame> can_frames;
+    std::vector<canfd_frame> canfd_frames;
+};
+
+struct TxStopResult {
+    int written = 0;
+    // Refused by the transport; flush() rewrites these ahead of every queue
+    int pending = 0;
+};
+
+struct TxQueueStats {
+    uint64_t sent = 0;
+    // Submitted frame refused because the class queue was full
+    uint64_t dropped_overflow = 0;
+    // Queued frame evicted to make room for a STOP frame
+    uint64_t evicted = 0;
+    // Queued frame replaced by a newer one with the same CAN ID
+    uint64_t coalesced = 0;
+    // Frame discarded after a non-retryable write error
+    uint64_t dropped_error = 0;
+    // Write refused with ENOBUFS/EAGAIN
+    uint64_t backpressure = 0;
+    // Frame discarded after exceeding the class retry limit
+    uint64_t dropped_backpressure = 0;
+    // Queued frame discarded because stop() was called after it was submitted
+    uint64_t dropped_stop = 0;
+};
+
+// Userspace TX scheduler with one bounded FIFO per priority class. flush()
+// always drains higher classes first, so a safety frame submitted behind a
+// backlog of control frames reaches the wire before them. When the socket
+// pushes back, the head frame is retried on later flush() calls up to its
+// class retry limit and then dropped, so frame loss stays bounded and counted.
+// A class with coalescing on merges a newer frame into a matching queued one.
+// A full queue refuses new frames, except STOP frames, which evict the
+// oldest queued non-STOP frame instead.
+// Not thread safe; use it from the control thread only. stop() is the
+// exception and may be called from any thread or a signal handler.
+class CANTxScheduler {
+public:
+    explicit CANTxScheduler(CANTransport& transport, size_t queue_capacity = 64);
+
+    // Queue a frame and flush. The owner, if any, has record_tx() called
+    // once the frame is finally written or dropped, including when a newer
+    // frame coalesces it away.
+    TxOutcome submit(const can_frame& frame, TxPriority priority,
+                     std::shared_ptr<CANDevice> owner = nullptr, TxKind kind = TxKind::NORMAL);
+    TxOutcome submit(const canfd_frame& frame, TxPriority priority,
+                     std::shared_ptr<CANDevice> owner = nullptr, TxKind kind = TxKind::NORMAL);
+
+    // Write queued frames in priority order until all are sent or the socket
+    // pushes back. Returns the number of frames written.
+    size_t flush();
+
+    // Emergency stop: write the stop frames right away and mark every frame
+    // queued so far as stale. flush() discards stale SAFETY and CONTROL
+    // frames other than STOP ones, so a queued enable or setpoint never
+    // reaches the wire after the stop. Stop frames the transport refuses
+    // stay pending and are rewritten ahead of every queue on each flush
+    // until they are written. Touches only atomics and the transport.
+    TxStopResult stop() noexcept;
+    // stop() without writing: every stop frame is left pending for the next
+    // flush(). Touches only atomics, for transports that are not
+    // async-signal-safe.
+    TxStopResult defer_stop() noexcept;
+    // The set stays owned by the caller and must outlive every stop() that
+    // may still be using it, including after it is replaced.
+    void set_stop_frames(const TxStopFrames* frames) {
+        stop_frames_.store(frames, std::memory_order_release);
+    }
+    // Stop frames waiting to be rewritten by flush()
+    size_t stop_pending() const;
+
+    size_t pending() const;
+    size_t pending(TxPriority priority) const {
+        return queues_[static_cast<size_t>(priority)].size;
+    }
+    const TxQueueStats& get_stats(TxPriority priority) const {
+        return queues_[static_cast<size_t>(priority)].stats;
+    }
+
+    // How many flush() calls may find a frame of this class refused with
+    // ENOBUFS before it is dropped. The unit is explicit flush() calls, i.e.
+    // recv_all()/flush_tx() cycles in OpenArm; refusals during submit() do
+    // not count, so a burst of submits never uses up a frame's retries.
+    // 0 drops it on the first refusal. Defaults favor delivery for safety
+    // and config frames, and freshness for the rest.
+    void set_retry_limit(TxPriority priority, uint32_t max_retries) {
+        queues_[static_cast<size_t>(priority)].max_retries = max_retries;
+    }
+    uint32_t get_retry_limit(TxPriority priority) const {
+        return queues_[static_cast<size_t>(priority)].max_retries;
+    }
+
+    // Replace a matching queued frame with a newer one instead of queueing
+    // both. Defaults: BY_FRAME for SAFETY, so a repeated enable is sent once
+    // but an enable never swallows a queued clear-error; BY_CAN_ID for
+    // CONTROL, where the latest setpoint for a motor wins; NONE for the
+    // rest, as register traffic for every motor shares CAN ID 0x7FF.
+    void set_coalescing(TxPriority priority, TxCoalescing coalescing) {
+        queues_[static_cast<size_t>(priority)].coalescing = coalescing;
+    }
+    TxCoalescing get_coalescing(TxPriority priority) const {
+        return queues_[static_cast<size_t>(priority)].coalescing;
+    }
+
+private:
+    struct Entry {
+        // can_frame is layout compatible with the head of canfd_frame
+        canfd_frame frame;
+        bool is_fd;
+        TxKind kind;
+        uint32_t retries;
+        // stop() epoch the frame was submitted under
+        uint32_t stop_epoch;
+        uint64_t sequence;
+        std::shared_ptr<CANDevice> owner;
+    };
+
+    struct Queue {
+        std::vector<Entry> ring;
+        size_t head = 0;
+        size_t size = 0;
+        uint32_t max_retries = 0;
+        TxCoalescing coalescing = TxCoalescing::NONE;
+        TxQueueStats stats;
+    };
+
+    TxOutcome enqueue_and_flush(Entry entry, TxPriority priority);
+    // count_retry is set for explicit flush() calls only
+    size_t flush_queues(bool count_retry);
+    // Discard frames made stale by stop() and rewrite pending stop frames.
+    // Returns false while stop frames are still pending.
+    bool settle_stop(size_t& written);
+    TxStopResult begin_stop(bool write) noexcept;
+    void discard_stale(Queue& queue, uint32_t epoch);
+    size_t write_stop_frames(const TxStopFrames& frames, size_t first);
+    size_t stop_frame_count(const TxStopFrames& frames) const;
+    void enqueue(Entry entry, TxPriority priority);
+    // Whether entry may replace queued under the queue's coalescing mode
+    static bool coalesces(const Queue& queue, const Entry& queued, const Entry& entry);
+    // Drop the queued frame at position index, counted from the head
+    void evict(Queue& queue, size_t index);
+    bool write_entry(const Entry& entry);
+    // Report the final outcome of a frame that leaves the scheduler
+    void finish(Entry& entry, bool sent);
+
+    CANTransport& transport_;
+    std::array<Queue, static_cast<size_t>(TxPriority::COUNT)> queues_;
+    uint64_t next_sequence_ = 0;
+    // Entry of the submit() in progress and its outcome so far
+    uint64_t submitted_sequence_ = 0;
+    TxOutcome submitted_outcome_ = TxOutcome::QUEUED;
+
+    std::atomic<const TxStopFrames*> stop_frames_{nullptr};
+    // Bumped by every stop()
+    std::atomic<uint32_t> stop_epoch_{0};
+    // Epoch of the stop() with unwritten frames in the upper 32 bits and the
+    // index of its first unwritten frame in the lower 32, or 0 when none
+    std::atomic<uint64_t> stop_pending_{0};
+    // Latest epoch whose stale frames flush() has discarded
+    uint32_t discarded_epoch_ = 0;
+};
+
+}  // namespace openarm::canbus
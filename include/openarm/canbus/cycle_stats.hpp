@@ -0,0 +1,91 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <time.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "latency_histogram.hpp"
+
+namespace openarm::canbus {
+
+// Phases of one command/reply cycle, in order
+enum class CyclePhase {
+    ENCODE,            // building command frames
+    TX,                // write syscalls and scheduler flushes
+    WAIT_FIRST_REPLY,  // first wait for a readable socket
+    DRAIN,             // later polls and read syscalls
+    DECODE,            // dispatching and decoding replies
+};
+
+constexpr size_t kCyclePhaseCount = 5;
+
+const char* to_string(CyclePhase phase);
+
+// Time spent per phase of each control cycle. Phases accumulate until
+// end_cycle() records one sample per phase. Not thread safe; the control
+// thread owns it.
+class CycleStats {
+public:
+    // CLOCK_MONOTONIC_RAW is immune to NTP slewing, so short intervals are
+    // not stretched or shrunk while the clock is being corrected.
+    static int64_t now_ns() noexcept {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    }
+
+    void add(CyclePhase phase, int64_t duration_ns) {
+        pending_ns_[static_cast<size_t>(phase)] += duration_ns;
+    }
+    void end_cycle();
+    void reset();
+
+    uint64_t get_cycles() const { return cycles_; }
+    // Phase time of the last completed cycle
+    int64_t get_last_ns(CyclePhase phase) const { return last_ns_[static_cast<size_t>(phase)]; }
+    const LatencyHistogram& get_histogram(CyclePhase phase) const {
+        return histograms_[static_cast<size_t>(phase)];
+    }
+
+private:
+    std::array<int64_t, kCyclePhaseCount> pending_ns_{};
+    std::array<int64_t, kCyclePhaseCount> last_ns_{};
+    std::array<LatencyHistogram, kCyclePhaseCount> histograms_;
+    uint64_t cycles_ = 0;
+};
+
+// Adds the lifetime of the scope to a phase; does nothing without stats
+class CyclePhaseTimer {
+public:
+    CyclePhaseTimer(CycleStats* stats, CyclePhase phase) noexcept
+        : stats_(stats), phase_(phase), start_ns_(stats ? CycleStats::now_ns() : 0) {}
+    ~CyclePhaseTimer() {
+        if (stats_) stats_->add(phase_, CycleStats::now_ns() - start_ns_);
+    }
+
+    CyclePhaseTimer(const CyclePhaseTimer&) = delete;
+    CyclePhaseTimer& operator=(const CyclePhaseTimer&) = delete;
+
+private:
+    CycleStats* stats_;
+    CyclePhase phase_;
+    int64_t start_ns_;
+};
+
+}  // namespace openarm::canbus
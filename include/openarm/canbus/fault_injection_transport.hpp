@@ -0,0 +1,116 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+
+#include "can_transport.hpp"
+
+namespace openarm::canbus {
+
+// Faults applied to one direction. Probabilities are per frame.
+struct FaultProfile {
+    double drop_probability = 0.0;
+    double duplicate_probability = 0.0;
+    // Hold the frame back until the next one has passed
+    double reorder_probability = 0.0;
+    // Flip one random payload bit, i.e. an error the CRC did not catch
+    double corrupt_probability = 0.0;
+    int delay_us = 0;
+    int delay_jitter_us = 0;  // uniform extra delay in [0, delay_jitter_us]
+    // TX only: refuse the write with ENOBUFS, as a full socket queue does
+    double refuse_probability = 0.0;
+};
+
+struct FaultStats {
+    uint64_t passed = 0;
+    uint64_t dropped = 0;
+    uint64_t duplicated = 0;
+    uint64_t reordered = 0;
+    uint64_t corrupted = 0;
+    uint64_t delayed = 0;
+    uint64_t write_failures = 0;  // delayed TX frames the inner transport refused
+    uint64_t refused = 0;         // TX writes failed with ENOBUFS
+};
+
+// Decorates another transport (CANSocket, LoopbackTransport, ...) and
+// injects faults on frames written (TX) and read (RX) through it. Delayed
+// frames are released by later calls on this transport; is_data_available()
+// wakes up in time for them. Thread safe.
+class FaultInjectionTransport : public CANTransport {
+public:
+    explicit FaultInjectionTransport(CANTransport& inner, uint64_t seed = 1);
+
+    void set_tx_profile(const FaultProfile& profile);
+    void set_rx_profile(const FaultProfile& profile);
+    FaultStats get_tx_stats() const;
+    FaultStats get_rx_stats() const;
+    CANTransport& get_inner() { return inner_; }
+
+    const std::string& get_interface() const override { return inner_.get_interface(); }
+    bool is_canfd_enabled() const override { return inner_.is_canfd_enabled(); }
+    // Readiness of the inner transport; frames held back by a delay do not
+    // make it readable, so prefer is_data_available() for waiting.
+    int get_socket_fd() const override { return inner_.get_socket_fd(); }
+    CANErrorMonitor& get_error_monitor() override { return inner_.get_error_monitor(); }
+
+    // Dropped frames still count as written, as on a real bus. A refused
+    // frame ends the batch with errno set to ENOBUFS.
+    int write_can_frames(const can_frame* frames, size_t count) override;
+    int write_canfd_frames(const canfd_frame* frames, size_t count) override;
+    int read_can_frames(can_frame* frames, size_t count) override;
+    int read_canfd_frames(canfd_frame* frames, size_t count) override;
+    bool is_data_available(int timeout_us = 100) override;
+
+private:
+    struct Entry {
+        int64_t due_ns;
+        canfd_frame frame;
+        bool is_fd;
+    };
+
+    struct Direction {
+        FaultProfile profile;
+        FaultStats stats;
+        std::deque<Entry> pending;  // ordered by due_ns
+        std::optional<Entry> held;  // frame waiting to be reordered
+        int64_t held_since_ns = 0;
+    };
+
+    bool refuse_tx();
+    void apply_faults(Direction& direction, const canfd_frame& frame, bool is_fd, int64_t now_ns);
+    void enqueue(Direction& direction, Entry entry);
+    void release_held(Direction& direction, int64_t now_ns, bool force);
+    void flush_tx(int64_t now_ns);
+    void pump_rx(int64_t now_ns);
+    int64_t next_due_ns() const;
+    template <typename Frame>
+    int read_frames(Frame* frames, size_t count, bool want_fd);
+
+    CANTransport& inner_;
+    mutable std::mutex mutex_;
+    std::mt19937_64 rng_;
+    Direction tx_;
+    Direction rx_;
+};
+
+}  // namespace openarm::canbus
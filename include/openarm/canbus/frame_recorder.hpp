@@ -0,0 +1,130 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "bounded_queue.hpp"
+
+namespace openarm::canbus {
+
+enum class FrameDirection : uint8_t { RX = 0, TX = 1 };
+
+// One recorded frame. Classic frames use the first len bytes of data.
+struct RecordedFrame {
+    uint64_t timestamp_ns;  // CLOCK_REALTIME, comparable with candump logs
+    canid_t can_id;
+    FrameDirection direction;
+    bool is_fd;
+    uint8_t flags;  // canfd_frame::flags
+    uint8_t len;
+    uint8_t data[CANFD_MAX_DLEN];
+};
+
+struct FrameRecorderOptions {
+    // Binary log read back by FrameLogReader; empty to skip
+    std::string binary_path;
+    // candump -l compatible text log; empty to skip
+    std::string text_path;
+    // Frames buffered between the hot path and the writer, rounded up to a
+    // power of two. Frames recorded while the ring is full are dropped.
+    size_t ring_capacity = 65536;
+    // How often the writer thread drains the ring
+    int drain_interval_ms = 10;
+};
+
+// Records TX and RX frames with timestamps. record() copies the frame into a
+// lock-free ring and returns; a background thread writes the files, so the
+// hot path never touches the disk.
+//
+// Binary format: the 8 byte magic "OACANLOG", a little-endian uint32 version
+// and uint32 interface name length, the name, then per frame a uint64
+// timestamp_ns, uint32 can_id, uint8 direction, is_fd, flags and len, and
+// len data bytes.
+class FrameRecorder {
+public:
+    // Throws std::runtime_error if a file cannot be created
+    FrameRecorder(const std::string& interface, const FrameRecorderOptions& options);
+    // Writes every recorded frame, then closes the files
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    void record(FrameDirection direction, const can_frame& frame) noexcept;
+    void record(FrameDirection direction, const canfd_frame& frame) noexcept;
+
+    // Wait until everything recorded so far is written and flushed
+    void flush();
+
+    const std::string& get_interface() const { return interface_; }
+    uint64_t get_recorded() const { return recorded_.load(std::memory_order_relaxed); }
+    uint64_t get_dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void push(FrameDirection direction, canid_t can_id, bool is_fd, uint8_t flags, uint8_t len,
+              const uint8_t* data) noexcept;
+    size_t drain();
+    void write_binary(const RecordedFrame& frame);
+    void write_text(const RecordedFrame& frame);
+    void run();
+
+    std::string interface_;
+    FrameRecorderOptions options_;
+    FILE* binary_file_ = nullptr;
+    FILE* text_file_ = nullptr;
+
+    BoundedQueue<RecordedFrame> queue_;
+    std::atomic<uint64_t> recorded_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable drained_;
+    uint64_t written_ = 0;
+    bool flush_requested_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+// Sequential reader for FrameRecorder binary logs
+class FrameLogReader {
+public:
+    // Throws std::runtime_error if the file is missing or not a frame log
+    explicit FrameLogReader(const std::string& path);
+    ~FrameLogReader();
+
+    FrameLogReader(const FrameLogReader&) = delete;
+    FrameLogReader& operator=(const FrameLogReader&) = delete;
+
+    const std::string& get_interface() const { return interface_; }
+    // Returns false at the end of the log or on a truncated or malformed
+    // record
+    bool next(RecordedFrame& frame);
+
+private:
+    FILE* file_;
+    std::string interface_;
+};
+
+}  // namespace openarm::canbus
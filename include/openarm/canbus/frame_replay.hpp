@@ -0,0 +1,53 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "can_device_collection.hpp"
+#include "frame_recorder.hpp"
+
+namespace openarm::canbus {
+
+// Load a FrameRecorder binary log or a candump -l text log, detected from
+// the file contents. candump frames are treated as received. Throws
+// std::runtime_error if the file cannot be read or parsed.
+std::vector<RecordedFrame> read_frame_log(const std::string& path);
+
+struct ReplayOptions {
+    // 1.0 keeps the recorded timing, 10.0 replays ten times faster and 0
+    // dispatches as fast as possible
+    double speed = 1.0;
+    // Also dispatch frames recorded as written by the host
+    bool include_tx = false;
+};
+
+struct ReplayStats {
+    uint64_t frames_dispatched = 0;
+    uint64_t frames_skipped = 0;
+    double elapsed_s = 0;
+    // Worst delay behind the scheduled dispatch time, when paced
+    int64_t max_lag_ns = 0;
+};
+
+// Feed recorded frames through collection.dispatch_frame_callback(), so the
+// registered devices decode them as if they came from the bus
+ReplayStats replay_frames(const std::vector<RecordedFrame>& frames,
+                          CANDeviceCollection& collection,
+                          const ReplayOptions& options = ReplayOptions());
+
+}  // namespace openarm::canbus
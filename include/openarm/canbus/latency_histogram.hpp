@@ -0,0 +1,59 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace openarm::canbus {
+
+// HDR-style log-linear histogram of nanosecond latencies. Values below 64 ns
+// are exact; above that each power of two is split into 32 buckets, so a
+// percentile is within ~3% of the true value. Recording is O(1) and
+// allocation free; not thread safe.
+class LatencyHistogram {
+public:
+    void record(uint64_t value_ns);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ == 0 ? 0 : min_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / count_; }
+    // Upper bound of the bucket holding the given percentile (0-100),
+    // capped at max()
+    uint64_t percentile(double percent) const;
+
+private:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr uint64_t kSubBucketCount = 1u << kSubBucketBits;
+    static constexpr uint64_t kLinearLimit = 2 * kSubBucketCount;
+    // Linear range plus 32 buckets for each exponent from 6 to 63
+    static constexpr size_t kBucketCount =
+        kLinearLimit + (64 - kSubBucketBits - 1) * kSubBucketCount;
+
+    static size_t bucket_index(uint64_t value_ns);
+    static uint64_t bucket_upper_bound(size_t index);
+
+    std::array<uint32_t, kBucketCount> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+};
+
+}  // namespace openarm::canbus
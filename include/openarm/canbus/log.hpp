@@ -0,0 +1,121 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "bounded_queue.hpp"
+#include "metrics.hpp"
+
+namespace openarm::canbus {
+
+enum class LogLevel { DEBUG = 0, INFO = 1, WARNING = 2, ERROR = 3 };
+
+const char* to_string(LogLevel level);
+
+// Receives formatted messages on the logger thread, never on the thread that
+// logged them, so a slow sink cannot stall a control loop.
+using LogSink = std::function<void(LogLevel level, const char* message)>;
+
+// Limits one call site to one message per interval. Suppressed messages are
+// counted and the count is reported with the next message that gets through.
+class LogThrottle {
+public:
+    explicit LogThrottle(int64_t interval_ns = 1000000000) : interval_ns_(interval_ns) {}
+
+    // Returns true if a message may be logged now; suppressed is set to the
+    // number of messages dropped since the last one allowed.
+    bool allow(uint64_t& suppressed) noexcept;
+
+private:
+    int64_t interval_ns_;
+    std::atomic<int64_t> next_allowed_ns_{0};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
+// Non-blocking diagnostics. Messages are formatted into a fixed-size lock-free
+// queue and handed to the sink by a background thread; when the queue is full
+// they are dropped and counted instead of waiting.
+class Logger {
+public:
+    static constexpr size_t kQueueSize = 256;
+    static constexpr size_t kMaxMessageLength = 192;
+
+    // Logger the library reports to. Its sink writes to stderr by default.
+    static Logger& global();
+
+    explicit Logger(MetricsRegistry& registry = MetricsRegistry::global());
+    // Delivers queued messages, then stops the logger thread
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Replace the sink; an empty sink restores the stderr default
+    void set_sink(LogSink sink);
+    // Messages below this level are discarded without formatting
+    void set_level(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+    LogLevel get_level() const { return level_.load(std::memory_order_relaxed); }
+
+    // printf-style. Never blocks, allocates or makes a system call other than
+    // waking the logger thread.
+    void log(LogLevel level, const char* format, ...) noexcept
+        __attribute__((format(printf, 3, 4)));
+    // Same, rate limited per call site by throttle
+    void log(LogThrottle& throttle, LogLevel level, const char* format, ...) noexcept
+        __attribute__((format(printf, 4, 5)));
+
+    // Wait until every queued message reached the sink
+    void flush();
+
+    uint64_t get_messages() const { return messages_.value(); }
+    uint64_t get_suppressed() const { return suppressed_.value(); }
+    uint64_t get_dropped() const { return dropped_.value(); }
+
+private:
+    struct Entry {
+        LogLevel level;
+        char message[kMaxMessageLength];
+    };
+
+    void enqueue(LogLevel level, uint64_t suppressed, const char* format, va_list args) noexcept;
+    void run();
+
+    BoundedQueue<Entry> queue_;
+    std::atomic<LogLevel> level_{LogLevel::INFO};
+
+    Counter& messages_;
+    Counter& suppressed_;
+    Counter& dropped_;
+    std::atomic<uint64_t> enqueued_{0};
+    uint64_t delivered_ = 0;
+
+    std::mutex sink_mutex_;
+    LogSink sink_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable drained_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+}  // namespace openarm::canbus
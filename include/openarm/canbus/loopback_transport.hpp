@@ -0,0 +1,86 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "can_transport.hpp"
+
+namespace openarm::canbus {
+
+// In-process transport. Frames written to an endpoint are delivered to its
+// connected peer, or handed to a TX handler that runs inline in the writer.
+// Receive queues are thread safe and an eventfd signals readiness, so an
+// endpoint can stand in for a CANSocket in select()/poll() loops.
+class LoopbackTransport : public CANTransport {
+public:
+    // Frame as seen by the TX handler; is_fd tells which struct was written
+    using TxHandler = std::function<void(const canfd_frame& frame, bool is_fd)>;
+
+    explicit LoopbackTransport(bool enable_fd = false, const std::string& interface = "loopback");
+    ~LoopbackTransport() override;
+
+    LoopbackTransport(const LoopbackTransport&) = delete;
+    LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+
+    // Connect two endpoints in both directions, like two nodes on one bus
+    static void connect(LoopbackTransport& a, LoopbackTransport& b);
+
+    // Run handler for every frame written to this endpoint instead of
+    // forwarding it to the peer. The handler may inject() replies.
+    void set_tx_handler(TxHandler tx_handler);
+
+    // Queue a frame for reading on this endpoint
+    void inject(const can_frame& frame);
+    void inject(const canfd_frame& frame);
+    size_t rx_pending() const;
+
+    const std::string& get_interface() const override { return interface_; }
+    bool is_canfd_enabled() const override { return fd_enabled_; }
+    int get_socket_fd() const override { return event_fd_; }
+
+    int write_can_frames(const can_frame* frames, size_t count) override;
+    int write_canfd_frames(const canfd_frame* frames, size_t count) override;
+    int read_can_frames(can_frame* frames, size_t count) override;
+    int read_canfd_frames(canfd_frame* frames, size_t count) override;
+    bool is_data_available(int timeout_us = 100) override;
+
+private:
+    struct Entry {
+        canfd_frame frame;
+        bool is_fd;
+    };
+
+    void deliver(const Entry& entry);
+    void push(const Entry& entry);
+    template <typename Frame>
+    int read_frames(Frame* frames, size_t count, bool want_fd);
+
+    std::string interface_;
+    bool fd_enabled_;
+    int event_fd_;
+    LoopbackTransport* peer_ = nullptr;
+    TxHandler tx_handler_;
+    mutable std::mutex rx_mutex_;
+    std::deque<Entry> rx_queue_;
+};
+
+}  // namespace openarm::canbus
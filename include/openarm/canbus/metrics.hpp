@@ -0,0 +1,125 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace openarm::canbus {
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Monotonically increasing count. Updates are relaxed atomics, so the hot
+// path never locks.
+class Counter {
+public:
+    void inc(uint64_t n = 1) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+// Value that can go up and down
+class Gauge {
+public:
+    void set(double value) noexcept { value_.store(value, std::memory_order_relaxed); }
+    double value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+// Named counters and gauges rendered in the Prometheus text format.
+// Registering a series takes a lock; the returned reference stays valid for
+// the lifetime of the registry and is updated lock free. Registering the same
+// name and labels again returns the existing series.
+class MetricsRegistry {
+public:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // Registry the library reports its bus and motor metrics to
+    static MetricsRegistry& global();
+
+    // Throws std::invalid_argument if name is already registered with the
+    // other metric type.
+    Counter& counter(const std::string& name, const std::string& help,
+                     const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help,
+                 const MetricLabels& labels = {});
+
+    // Prometheus text exposition format, families sorted by name
+    std::string render() const;
+    // Write render() to path for the node_exporter textfile collector. The
+    // file is written next to path and renamed over it, so scrapes never see
+    // a partial file.
+    bool write_textfile(const std::string& path) const;
+
+private:
+    struct Family {
+        std::string help;
+        bool is_counter = true;
+        // Rendered label set -> series
+        std::map<std::string, void*> series;
+    };
+
+    template <typename Metric>
+    Metric& get_or_create(const std::string& name, const std::string& help,
+                          const MetricLabels& labels, bool is_counter, std::deque<Metric>& store);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+    std::deque<Counter> counters_;
+    std::deque<Gauge> gauges_;
+};
+
+// Periodically writes a registry to a textfile from a background thread
+class MetricsTextfileWriter {
+public:
+    MetricsTextfileWriter(MetricsRegistry& registry, const std::string& path,
+                          int interval_ms = 1000);
+    // Stops the thread and writes the file one last time
+    ~MetricsTextfileWriter();
+
+    MetricsTextfileWriter(const MetricsTextfileWriter&) = delete;
+    MetricsTextfileWriter& operator=(const MetricsTextfileWriter&) = delete;
+
+    const std::string& get_path() const { return path_; }
+    uint64_t get_write_failures() const { return write_failures_.load(); }
+
+private:
+    void run();
+
+    MetricsRegistry& registry_;
+    std::string path_;
+    int interval_ms_;
+    std::atomic<uint64_t> write_failures_{0};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+}  // namespace openarm::canbus
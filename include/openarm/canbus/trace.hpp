@@ -0,0 +1,125 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "bounded_queue.hpp"
+
+namespace openarm::canbus {
+
+// Writes complete ("X") events in the Chrome trace event JSON format, which
+// chrome://tracing and ui.perfetto.dev open directly. Events are queued
+// lock free and written by a background thread.
+class TraceRecorder {
+public:
+    // Throws std::runtime_error if path cannot be created
+    explicit TraceRecorder(const std::string& path, size_t ring_capacity = 65536,
+                           int drain_interval_ms = 10);
+    // Deactivates the recorder, waits for scopes still open on other threads
+    // to close, then writes the queued events and closes the JSON array.
+    // Scopes open on the destroying thread are dropped. Scopes of another
+    // recorder on other threads are waited for too, as they share one count.
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // name and category must be string literals or otherwise outlive the
+    // recorder; they are stored by pointer.
+    void record(const char* category, const char* name, int64_t start_ns,
+                int64_t duration_ns) noexcept;
+    void flush();
+
+    uint64_t get_recorded() const { return recorded_.load(std::memory_order_relaxed); }
+    uint64_t get_dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Recorder that TraceScope reports to, or nullptr (the default) to
+    // disable tracing
+    static void set_active(TraceRecorder* recorder) { active_.store(recorder); }
+    static TraceRecorder* active() noexcept { return active_.load(std::memory_order_acquire); }
+
+    static int64_t now_ns() noexcept;
+
+private:
+    friend class TraceScope;
+
+    struct Event {
+        const char* category;
+        const char* name;
+        int64_t start_ns;
+        int64_t duration_ns;
+        uint32_t tid;
+    };
+
+    size_t drain();
+    void run();
+
+    static std::atomic<TraceRecorder*> active_;
+    // Open TraceScopes of every recorder. A scope counts itself before it
+    // loads active_, and ~TraceRecorder clears active_ before waiting for
+    // the count to drop, so a recorder a scope took outlives the scope. The
+    // count is global because a per-recorder one would be touched after a
+    // racing destructor freed it.
+    static std::atomic<uint32_t> scope_users_;
+
+    FILE* file_;
+    int drain_interval_ms_;
+    BoundedQueue<Event> queue_;
+    std::atomic<uint64_t> recorded_{0};
+    std::atomic<uint64_t> dropped_{0};
+    bool first_event_ = true;
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable drained_;
+    uint64_t written_ = 0;
+    bool flush_requested_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+// Records the lifetime of the scope as one trace event. Costs a single atomic
+// load when no recorder is active.
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name) noexcept
+        : category_(category), name_(name) {
+        if (TraceRecorder::active()) open();
+    }
+    ~TraceScope() {
+        if (recorder_) close();
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    void open() noexcept;
+    void close() noexcept;
+
+    TraceRecorder* recorder_ = nullptr;
+    const char* category_;
+    const char* name_;
+    int64_t start_ns_ = 0;
+};
+
+}  // namespace openarm::canbus
@@ -45,6 +45,11 @@ public:
     // Enable status getters
     bool is_enabled() const { return enabled_; }
 
+    // Status/fault code reported in the latest state reply. Independent of
+    // is_enabled(): a commanded motor may still report DISABLED or a fault.
+    MotorStatus get_status() const { return status_; }
+    bool has_fault() const { return is_fault_status(status_); }
+
     // Parameter methods
     double get_param(int RID) const;
 
@@ -57,6 +62,7 @@ protected:
     void set_state_tmos(int tmos);
     void set_state_trotor(int trotor);
     void set_enabled(bool enabled);
+    void set_status(MotorStatus status);
     void set_temp_param(int RID, double val);
 
     // Motor identifiers
@@ -66,6 +72,7 @@ protected:
 
     // Enable status
     bool enabled_;
+    MotorStatus status_;
 
     // Current state
     double state_q_, state_dq_, state_tau_;
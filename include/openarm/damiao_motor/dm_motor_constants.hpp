@@ -38,6 +38,45 @@ enum class MotorType : uint8_t {
 
 enum class ControlMode : uint8_t { MIT = 1, POS_VEL = 2, VEL = 3, POS_FORCE = 4 };
 
+// Status code carried in the upper nibble of D[0] of every state reply.
+// Codes >= 0x8 are faults; the motor stops driving until the error is cleared.
+enum class MotorStatus : uint8_t {
+    DISABLED = 0x0,
+    ENABLED = 0x1,
+    OVER_VOLTAGE = 0x8,
+    UNDER_VOLTAGE = 0x9,
+    OVER_CURRENT = 0xA,
+    MOS_OVER_TEMP = 0xB,
+    ROTOR_OVER_TEMP = 0xC,
+    COMM_LOSS = 0xD,
+    OVERLOAD = 0xE,
+    // A nibble Damiao does not document (0x2-0x7, 0xF)
+    UNKNOWN = 0xFF
+};
+
+// Status from the upper nibble of a state reply's first byte
+inline constexpr MotorStatus motor_status_from_nibble(uint8_t nibble) {
+    switch (nibble) {
+        case 0x0:
+        case 0x1:
+        case 0x8:
+        case 0x9:
+        case 0xA:
+        case 0xB:
+        case 0xC:
+        case 0xD:
+        case 0xE:
+            return static_cast<MotorStatus>(nibble);
+        default:
+            return MotorStatus::UNKNOWN;
+    }
+}
+
+inline constexpr bool is_fault_status(MotorStatus status) {
+    return static_cast<uint8_t>(status) >= static_cast<uint8_t>(MotorStatus::OVER_VOLTAGE) &&
+           status != MotorStatus::UNKNOWN;
+}
+
 enum class RID : uint8_t {
     UV_Value = 0,
     KT_Value = 1,
@@ -40,6 +40,7 @@ struct StateResult {
     double torque;
     int t_mos;
     int t_rotor;
+    MotorStatus status;  // Upper nibble of D[0]
     bool valid;
 };
 
@@ -76,6 +77,7 @@ public:
     static CANPacket create_enable_command(const Motor& motor);
     static CANPacket create_disable_command(const Motor& motor);
     static CANPacket create_set_zero_command(const Motor& motor);
+    static CANPacket create_clear_error_command(const Motor& motor);
     static CANPacket create_mit_control_command(const Motor& motor, const MITParam& mit_param);
     static CANPacket create_posvel_control_command(const Motor& motor,
                                                    const PosVelParam& posvel_param);
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <array>
+#include <functional>
+#include <utility>
+
 #include "../canbus/can_device.hpp"
 #include "../canbus/can_socket.hpp"
 #include "dm_motor.hpp"
@@ -27,6 +31,13 @@ enum CallbackMode {
     IGNORE
 };
 
+// Commands whose frames never change for a given motor. DMCANDevice builds
+// them once at construction so sending one is a plain buffer write.
+enum class ConstantCommand : uint8_t { ENABLE = 0, DISABLE, REFRESH, CLEAR_ERROR, COUNT };
+
+// Called from the receive path when a motor reports a new fault status.
+using FaultCallback = std::function<void(const Motor& motor, MotorStatus status)>;
+
 class DMCANDevice : public canbus::CANDevice {
 public:
     explicit DMCANDevice(Motor& motor, canid_t recv_can_mask, bool use_fd);
@@ -36,18 +47,35 @@ public:
     // Create frame from data array
     can_frame create_can_frame(canid_t send_can_id, std::vector<uint8_t> data);
     canfd_frame create_canfd_frame(canid_t send_can_id, std::vector<uint8_t> data);
+    // Prebuilt frames for constant commands
+    const can_frame& get_constant_can_frame(ConstantCommand command) const {
+        return constant_can_frames_[static_cast<size_t>(command)];
+    }
+    const canfd_frame& get_constant_canfd_frame(ConstantCommand command) const {
+        return constant_canfd_frames_[static_cast<size_t>(command)];
+    }
     // Getter method to access motor state
     Motor& get_motor() { return motor_; }
     void set_callback_mode(CallbackMode callback_mode) { callback_mode_ = callback_mode; }
     ControlMode get_control_mode() const { return control_mode_; }
     void set_control_mode(ControlMode control_mode) { control_mode_ = control_mode; }
+    // The callback fires once per transition into a fault status, in the
+    // same recv call that decoded the state frame.
+    void set_fault_callback(FaultCallback fault_callback) {
+        fault_callback_ = std::move(fault_callback);
+    }
 
 private:
+    void apply_state_result(const StateResult& result);
+    void build_constant_frames();
     std::vector<uint8_t> get_data_from_frame(const can_frame& frame);
     std::vector<uint8_t> get_data_from_frame(const canfd_frame& frame);
     Motor& motor_;
     CallbackMode callback_mode_;
     bool use_fd_;  // Track if using CAN-FD
     ControlMode control_mode_ = ControlMode::MIT;
+    FaultCallback fault_callback_;
+    std::array<can_frame, static_cast<size_t>(ConstantCommand::COUNT)> constant_can_frames_;
+    std::array<canfd_frame, static_cast<size_t>(ConstantCommand::COUNT)> constant_canfd_frames_;
 };
 }  // namespace openarm::damiao_motor
@@ -18,6 +18,8 @@
 #include <vector>
 
 #include "../canbus/can_device_collection.hpp"
+#include "../canbus/can_tx_scheduler.hpp"
+#include "../canbus/cycle_stats.hpp"
 #include "dm_motor_constants.hpp"
 #include "dm_motor_control.hpp"
 #include "dm_motor_device.hpp"
@@ -26,13 +28,18 @@ namespace openarm::damiao_motor {
 
 class DMDeviceCollection {
 public:
-    DMDeviceCollection(canbus::CANSocket& can_socket);
+    DMDeviceCollection(canbus::CANTransport& transport);
     virtual ~DMDeviceCollection() = default;
 
     // Common motor operations
     void enable_all();
     void disable_all();
     void set_callback_mode_all(CallbackMode callback_mode);
+    void set_fault_callback_all(const FaultCallback& fault_callback);
+
+    // Clear a latched fault (0xFB)
+    void clear_error_one(int i);
+    void clear_error_all();
 
     // Flash new zero position
     void set_zero(int i);
@@ -71,14 +78,36 @@ public:
     Motor get_motor(int i) const;
     canbus::CANDeviceCollection& get_device_collection() { return *device_collection_; }
 
+    // Per-motor command-to-reply latency
+    const canbus::LatencyHistogram& get_rtt_histogram(int i) const;
+    void reset_rtt_histograms();
+
+    // Route frames through a shared priority scheduler instead of writing
+    // them to the socket directly. Pass nullptr to write directly.
+    void set_tx_scheduler(canbus::CANTxScheduler* tx_scheduler) { tx_scheduler_ = tx_scheduler; }
+    // Accumulate encode and TX time into the given stats. Pass nullptr to stop.
+    void set_cycle_stats(canbus::CycleStats* cycle_stats) { cycle_stats_ = cycle_stats; }
+
 protected:
-    canbus::CANSocket& can_socket_;
+    canbus::CANTransport& transport_;
     std::unique_ptr<CanPacketEncoder> can_packet_encoder_;
     std::unique_ptr<CanPacketDecoder> can_packet_decoder_;
     std::unique_ptr<canbus::CANDeviceCollection> device_collection_;
+    canbus::CANTxScheduler* tx_scheduler_ = nullptr;
+    canbus::CycleStats* cycle_stats_ = nullptr;
 
     // Helper methods for subclasses
-    void send_command_to_device(std::shared_ptr<DMCANDevice> dm_device, const CANPacket& packet);
+    void send_command_to_device(std::shared_ptr<DMCANDevice> dm_device, const CANPacket& packet,
+                                canbus::TxPriority priority = canbus::TxPriority::CONTROL);
+    void send_constant_command_to_device(const std::shared_ptr<DMCANDevice>& dm_device,
+                                         ConstantCommand command);
+    // Write or schedule a frame; the device's TX counters see the final outcome
+    void write_frame(const can_frame& frame, canbus::TxPriority priority,
+                     const std::shared_ptr<DMCANDevice>& dm_device,
+                     canbus::TxKind kind = canbus::TxKind::NORMAL);
+    void write_frame(const canfd_frame& frame, canbus::TxPriority priority,
+                     const std::shared_ptr<DMCANDevice>& dm_device,
+                     canbus::TxKind kind = canbus::TxKind::NORMAL);
     std::vector<std::shared_ptr<DMCANDevice>> get_dm_devices() const;
 };
 }  // namespace openarm::damiao_motor
@@ -0,0 +1,45 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../canbus/can_transport.hpp"
+
+namespace openarm::damiao_motor {
+
+struct DiscoveryOptions {
+    // How long to collect replies after each round of queries
+    int window_us = 50000;
+    // Further rounds, each querying only the IDs that stayed silent
+    int retries = 2;
+};
+
+// A motor that answered: commands go to slave_id, replies come from master_id
+struct DiscoveredMotorID {
+    uint32_t slave_id;
+    uint32_t master_id;
+};
+
+// Find which of slave_ids answer on the transport's bus. Every silent ID is
+// sent an MST_ID register read back to back, then replies are collected in
+// one receive window, so a round costs about window_us regardless of the
+// number of IDs. Results are in slave_ids order.
+std::vector<DiscoveredMotorID> discover_motors(canbus::CANTransport& transport,
+                                               const std::vector<uint32_t>& slave_ids,
+                                               const DiscoveryOptions& options = {});
+
+}  // namespace openarm::damiao_motor
@@ -0,0 +1,133 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/can.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../canbus/can_transport.hpp"
+#include "dm_motor_constants.hpp"
+
+namespace openarm::damiao_motor {
+
+// State of one emulated motor
+struct SimulatedMotor {
+    MotorType motor_type;
+    uint32_t slave_id;   // ESC_ID: where the host sends commands
+    uint32_t master_id;  // MST_ID: where the motor replies
+    ControlMode control_mode = ControlMode::MIT;
+    MotorStatus status = MotorStatus::DISABLED;
+    double position = 0.0;
+    double velocity = 0.0;
+    double torque = 0.0;  // applied torque after limits
+    int t_mos = 30;
+    int t_rotor = 30;
+    // Latest command; its meaning depends on control_mode
+    double kp = 0.0;
+    double kd = 0.0;
+    double q_des = 0.0;
+    double dq_des = 0.0;
+    double tau_ff = 0.0;
+    double current_limit = 1.0;  // POS_FORCE per-unit torque limit
+    // Register file; Inertia (kg m^2) and Damp (Nm s/rad) drive the dynamics
+    std::map<int, double> params;
+};
+
+// Emulates Damiao motors on a CANTransport: a vcan CANSocket or one end of
+// a LoopbackTransport pair. It answers enable/disable/zero/clear-error, the
+// MIT/POS_VEL/VEL/POS_FORCE control IDs (+0x000/+0x100/+0x200/+0x300) and
+// 0x7FF register read/write/refresh with encoded reply frames.
+//
+// Each joint is a first-order rigid body, J * ddq = tau - b * dq, stepped at a
+// fixed physics rate. tau follows the MIT law kp * (q_des - q) + kd * (dq_des
+// - dq) + tau_ff, or an internal position/velocity loop in the other modes,
+// and is clamped to the motor's MOTOR_LIMIT_PARAMS torque limit.
+class DMMotorSimulator {
+public:
+    explicit DMMotorSimulator(canbus::CANTransport& transport);
+    ~DMMotorSimulator();
+
+    DMMotorSimulator(const DMMotorSimulator&) = delete;
+    DMMotorSimulator& operator=(const DMMotorSimulator&) = delete;
+
+    void add_motor(MotorType motor_type, uint32_t slave_id, uint32_t master_id,
+                   double inertia = 0.01, double damping = 0.02);
+    // Delay between receiving a command and sending its reply
+    void set_reply_latency_us(int reply_latency_us) { reply_latency_us_ = reply_latency_us; }
+    // Internal integration rate; poll() catches up with wall time in fixed steps
+    void set_physics_rate_hz(double physics_rate_hz);
+    // Latch a fault; it is reported until the host sends clear-error
+    void inject_fault(uint32_t slave_id, MotorStatus status);
+
+    // Handle one frame addressed to the bus. Thread safe, so it can be used
+    // directly as a LoopbackTransport TX handler.
+    void handle_frame(const canfd_frame& frame, bool is_fd);
+
+    // Read pending frames from the transport, handle them and send replies
+    // that are due. Waits up to timeout_us for the first frame.
+    void poll(int timeout_us = 0);
+
+    // Run poll() on a background thread until stop()
+    void start();
+    void stop();
+
+    // Advance every motor by dt seconds, independent of wall time
+    void step(double dt);
+
+    SimulatedMotor get_motor(uint32_t slave_id) const;
+    uint64_t get_frames_received() const { return frames_received_.load(); }
+    uint64_t get_frames_replied() const { return frames_replied_.load(); }
+
+private:
+    struct PendingReply {
+        int64_t due_ns;
+        canfd_frame frame;
+        bool is_fd;
+    };
+
+    SimulatedMotor* find_motor(uint32_t slave_id);
+    void handle_command(SimulatedMotor& motor, const canfd_frame& frame, bool is_fd);
+    void handle_register_frame(const canfd_frame& frame, bool is_fd);
+    void queue_state_reply(const SimulatedMotor& motor, bool is_fd);
+    void queue_register_reply(const SimulatedMotor& motor, uint8_t command, uint8_t rid,
+                              bool is_fd);
+    void queue_reply(const canfd_frame& frame, bool is_fd);
+    void send_due_replies(int64_t now_ns);
+    void advance_to(int64_t now_ns);
+    void step_locked(double dt);
+    static double compute_torque(const SimulatedMotor& motor);
+    void write_frame(const canfd_frame& frame, bool is_fd);
+
+    canbus::CANTransport& transport_;
+    std::atomic<int> reply_latency_us_{0};
+    mutable std::mutex mutex_;
+    std::vector<SimulatedMotor> motors_;
+    std::deque<PendingReply> pending_replies_;
+    int64_t step_period_ns_ = 1000000;
+    int64_t last_step_ns_ = 0;
+    std::atomic<uint64_t> frames_received_{0};
+    std::atomic<uint64_t> frames_replied_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+}  // namespace openarm::damiao_motor
@@ -24,6 +24,7 @@ Source:         https://github.com/enactic/openarm_can/archive/%{version}/openar
 BuildRequires:  cli11-devel
 BuildRequires:  cmake
 BuildRequires:  gcc-c++
+BuildRequires:  gtest-devel
 
 %description
 A C++ library for CAN communication with OpenArm robotic hardware,
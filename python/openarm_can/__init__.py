@@ -31,6 +31,11 @@ __all__ = [
     "MotorType",
     "MotorVariable",
     "CallbackMode",
+    "LogLevel",
+    "MotorStatus",
+    "CANBusState",
+    "CANErrorClass",
+    "BusOffRecovery",
 
     # Data structures
     "LimitParam",
@@ -38,7 +43,16 @@ __all__ = [
     "MotorStateResult",
     "CanFrame",
     "CanFdFrame",
+    "CANErrorEvent",
+    "CANInterfaceStatus",
+    "CANInterfaceConfig",
+    "DiscoveryOptions",
+    "DiscoveredMotorID",
+    "BusTiming",
     "MITParam",
+    "LatencyHistogram",
+    "CyclePhase",
+    "CycleStats",
 
     # Main C++ classes (1:1 mapping)
     "Motor",
@@ -47,7 +61,21 @@ __all__ = [
     "CANDevice",           # Base CAN device class
     "MotorDeviceCan",      # Motor device management
     "CANDeviceCollection",  # Device collection management
+    "MetricsRegistry",     # Prometheus counters and gauges
+    "MetricsTextfileWriter",
+    "Logger",              # Rate-limited diagnostics sink
+    "FrameDirection",
+    "FrameRecorderOptions",
+    "FrameRecorder",       # TX/RX frame log
+    "TraceRecorder",       # Control cycle phase trace
+    "CANInterfaceMonitor",  # Kernel CAN state and statistics poller
+    "read_can_interface_status",
+    "restart_can_interface",
+    "configure_can_interface",
+    "set_can_interface_up",
+    "discover_motors",
 
     # Exceptions
     "CANSocketException",
+    "CANNetlinkException",
 ]
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/function.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
@@ -26,12 +27,22 @@
 #include <openarm/can/socket/openarm.hpp>
 #include <openarm/canbus/can_device.hpp>
 #include <openarm/canbus/can_device_collection.hpp>
+#include <openarm/canbus/can_error.hpp>
+#include <openarm/canbus/can_interface_monitor.hpp>
+#include <openarm/canbus/can_netlink.hpp>
 #include <openarm/canbus/can_socket.hpp>
+#include <openarm/canbus/cycle_stats.hpp>
+#include <openarm/canbus/frame_recorder.hpp>
+#include <openarm/canbus/latency_histogram.hpp>
+#include <openarm/canbus/log.hpp>
+#include <openarm/canbus/metrics.hpp>
+#include <openarm/canbus/trace.hpp>
 #include <openarm/damiao_motor/dm_motor.hpp>
 #include <openarm/damiao_motor/dm_motor_constants.hpp>
 #include <openarm/damiao_motor/dm_motor_control.hpp>
 #include <openarm/damiao_motor/dm_motor_device.hpp>
 #include <openarm/damiao_motor/dm_motor_device_collection.hpp>
+#include <openarm/damiao_motor/dm_motor_discovery.hpp>
 
 using namespace openarm::canbus;
 using namespace openarm::damiao_motor;
@@ -128,6 +139,19 @@ NB_MODULE(openarm_can, m) {
         .value("POS_FORCE", ControlMode::POS_FORCE)
         .export_values();
 
+    nb::enum_<MotorStatus>(m, "MotorStatus")
+        .value("DISABLED", MotorStatus::DISABLED)
+        .value("ENABLED", MotorStatus::ENABLED)
+        .value("OVER_VOLTAGE", MotorStatus::OVER_VOLTAGE)
+        .value("UNDER_VOLTAGE", MotorStatus::UNDER_VOLTAGE)
+        .value("OVER_CURRENT", MotorStatus::OVER_CURRENT)
+        .value("MOS_OVER_TEMP", MotorStatus::MOS_OVER_TEMP)
+        .value("ROTOR_OVER_TEMP", MotorStatus::ROTOR_OVER_TEMP)
+        .value("COMM_LOSS", MotorStatus::COMM_LOSS)
+        .value("OVERLOAD", MotorStatus::OVERLOAD)
+        .value("UNKNOWN", MotorStatus::UNKNOWN)
+        .export_values();
+
     // ============================================================================
     // DAMIAO MOTOR NAMESPACE - STRUCTS
     // ============================================================================
@@ -154,6 +178,7 @@ NB_MODULE(openarm_can, m) {
         .def_rw("torque", &StateResult::torque)
         .def_rw("t_mos", &StateResult::t_mos)
         .def_rw("t_rotor", &StateResult::t_rotor)
+        .def_rw("status", &StateResult::status)
         .def_rw("valid", &StateResult::valid);
 
     // CANPacket struct
@@ -227,6 +252,8 @@ NB_MODULE(openarm_can, m) {
         .def("get_recv_can_id", &Motor::get_recv_can_id)
         .def("get_motor_type", &Motor::get_motor_type)
         .def("is_enabled", &Motor::is_enabled)
+        .def("get_status", &Motor::get_status)
+        .def("has_fault", &Motor::has_fault)
         .def("get_param", &Motor::get_param, nb::arg("rid"))
         .def_static("get_limit_param", &Motor::get_limit_param, nb::arg("motor_type"));
 
@@ -240,6 +267,8 @@ NB_MODULE(openarm_can, m) {
                     nb::arg("motor"))
         .def_static("create_set_zero_command", &CanPacketEncoder::create_set_zero_command,
                     nb::arg("motor"))
+        .def_static("create_clear_error_command", &CanPacketEncoder::create_clear_error_command,
+                    nb::arg("motor"))
         .def_static("create_mit_control_command", &CanPacketEncoder::create_mit_control_command,
                     nb::arg("motor"), nb::arg("mit_param"))
         .def_static("create_posvel_control_command",
@@ -265,13 +294,75 @@ NB_MODULE(openarm_can, m) {
 
     // CAN Socket Exception
     nb::exception<CANSocketException>(m, "CANSocketException");
+    nb::exception<CANNetlinkException>(m, "CANNetlinkException");
+
+    nb::class_<LatencyHistogram>(m, "LatencyHistogram")
+        .def(nb::init<>())
+        .def("record", &LatencyHistogram::record, nb::arg("value_ns"))
+        .def("reset", &LatencyHistogram::reset)
+        .def("count", &LatencyHistogram::count)
+        .def("min", &LatencyHistogram::min)
+        .def("max", &LatencyHistogram::max)
+        .def("mean", &LatencyHistogram::mean)
+        .def("percentile", &LatencyHistogram::percentile, nb::arg("percent"));
+
+    nb::enum_<CyclePhase>(m, "CyclePhase")
+        .value("ENCODE", CyclePhase::ENCODE)
+        .value("TX", CyclePhase::TX)
+        .value("WAIT_FIRST_REPLY", CyclePhase::WAIT_FIRST_REPLY)
+        .value("DRAIN", CyclePhase::DRAIN)
+        .value("DECODE", CyclePhase::DECODE);
+
+    // Per-phase time of each command/reply cycle
+    nb::class_<CycleStats>(m, "CycleStats")
+        .def("get_cycles", &CycleStats::get_cycles)
+        .def("get_last_ns", &CycleStats::get_last_ns, nb::arg("phase"))
+        .def("get_histogram", &CycleStats::get_histogram, nb::arg("phase"),
+             nb::rv_policy::reference_internal);
+
+    // Bus and motor counters in the Prometheus text format
+    nb::class_<MetricsRegistry>(m, "MetricsRegistry")
+        .def_static("global_registry", &MetricsRegistry::global, nb::rv_policy::reference)
+        .def("render", &MetricsRegistry::render)
+        .def("write_textfile", &MetricsRegistry::write_textfile, nb::arg("path"));
+
+    nb::enum_<LogLevel>(m, "LogLevel")
+        .value("DEBUG", LogLevel::DEBUG)
+        .value("INFO", LogLevel::INFO)
+        .value("WARNING", LogLevel::WARNING)
+        .value("ERROR", LogLevel::ERROR);
+
+    // Library diagnostics; the sink is called from the logger thread
+    nb::class_<Logger>(m, "Logger")
+        .def_static("global_logger", &Logger::global, nb::rv_policy::reference)
+        .def("set_sink", &Logger::set_sink, nb::arg("sink"),
+             nb::call_guard<nb::gil_scoped_release>())
+        .def("set_level", &Logger::set_level, nb::arg("level"))
+        .def("get_level", &Logger::get_level)
+        .def("flush", &Logger::flush, nb::call_guard<nb::gil_scoped_release>())
+        .def("get_messages", &Logger::get_messages)
+        .def("get_suppressed", &Logger::get_suppressed)
+        .def("get_dropped", &Logger::get_dropped);
+
+    nb::class_<MetricsTextfileWriter>(m, "MetricsTextfileWriter")
+        .def(nb::init<MetricsRegistry&, const std::string&, int>(), nb::arg("registry"),
+             nb::arg("path"), nb::arg("interval_ms") = 1000, nb::keep_alive<1, 2>())
+        .def("get_path", &MetricsTextfileWriter::get_path)
+        .def("get_write_failures", &MetricsTextfileWriter::get_write_failures);
 
     // CANDevice base class (MUST be defined before derived classes)
     nb::class_<CANDevice>(m, "CANDevice")
         .def("get_send_can_id", &CANDevice::get_send_can_id)
         .def("get_recv_can_id", &CANDevice::get_recv_can_id)
         .def("get_recv_can_mask", &CANDevice::get_recv_can_mask)
-        .def("is_fd_enabled", &CANDevice::is_fd_enabled);
+        .def("is_fd_enabled", &CANDevice::is_fd_enabled)
+        .def("get_tx_frames", &CANDevice::get_tx_frames)
+        .def("get_tx_failures", &CANDevice::get_tx_failures)
+        .def("get_rx_frames", &CANDevice::get_rx_frames)
+        .def("get_decode_errors", &CANDevice::get_decode_errors)
+        .def("get_rejected_commands", &CANDevice::get_rejected_commands)
+        .def("get_rtt_histogram", &CANDevice::get_rtt_histogram, nb::rv_policy::reference_internal)
+        .def("reset_rtt_histogram", &CANDevice::reset_rtt_histogram);
 
     // MotorDeviceCan class (NOW can inherit from CANDevice)
     nb::class_<DMCANDevice, CANDevice>(m, "MotorDeviceCan")
@@ -288,7 +379,8 @@ NB_MODULE(openarm_can, m) {
              nb::arg("data"))
         .def("create_canfd_frame", &DMCANDevice::create_canfd_frame, nb::arg("send_can_id"),
              nb::arg("data"))
-        .def("set_callback_mode", &DMCANDevice::set_callback_mode, nb::arg("callback_mode"));
+        .def("set_callback_mode", &DMCANDevice::set_callback_mode, nb::arg("callback_mode"))
+        .def("set_fault_callback", &DMCANDevice::set_fault_callback, nb::arg("fault_callback"));
 
     // CANDeviceCollection class
     nb::class_<CANDeviceCollection>(m, "CANDeviceCollection")
@@ -313,7 +405,50 @@ NB_MODULE(openarm_can, m) {
              static_cast<void (CANDeviceCollection::*)(canfd_frame&)>(
                  &CANDeviceCollection::dispatch_frame_callback),
              nb::arg("frame"))
-        .def("get_devices", &CANDeviceCollection::get_devices);
+        .def("get_devices", &CANDeviceCollection::get_devices)
+        .def("get_unknown_id_frames", &CANDeviceCollection::get_unknown_id_frames);
+
+    nb::enum_<FrameDirection>(m, "FrameDirection")
+        .value("RX", FrameDirection::RX)
+        .value("TX", FrameDirection::TX);
+
+    nb::class_<FrameRecorderOptions>(m, "FrameRecorderOptions")
+        .def(nb::init<>())
+        .def_rw("binary_path", &FrameRecorderOptions::binary_path)
+        .def_rw("text_path", &FrameRecorderOptions::text_path)
+        .def_rw("ring_capacity", &FrameRecorderOptions::ring_capacity)
+        .def_rw("drain_interval_ms", &FrameRecorderOptions::drain_interval_ms);
+
+    // Binary and candump-style frame log written from a background thread
+    nb::class_<FrameRecorder>(m, "FrameRecorder")
+        .def(nb::init<const std::string&, const FrameRecorderOptions&>(), nb::arg("interface"),
+             nb::arg("options"))
+        .def("flush", &FrameRecorder::flush, nb::call_guard<nb::gil_scoped_release>())
+        .def("get_interface", &FrameRecorder::get_interface)
+        .def("get_recorded", &FrameRecorder::get_recorded)
+        .def("get_dropped", &FrameRecorder::get_dropped);
+
+    // Chrome/Perfetto trace of control cycle phases
+    nb::class_<TraceRecorder>(m, "TraceRecorder")
+        .def(nb::init<const std::string&, size_t, int>(), nb::arg("path"),
+             nb::arg("ring_capacity") = 65536, nb::arg("drain_interval_ms") = 10)
+        .def("flush", &TraceRecorder::flush, nb::call_guard<nb::gil_scoped_release>())
+        .def("get_recorded", &TraceRecorder::get_recorded)
+        .def("get_dropped", &TraceRecorder::get_dropped)
+        .def_static("set_active", &TraceRecorder::set_active, nb::arg("recorder").none())
+        .def_static("active", &TraceRecorder::active, nb::rv_policy::reference);
+
+    nb::class_<BusTiming>(m, "BusTiming")
+        .def(nb::init<>())
+        .def_rw("bitrate", &BusTiming::bitrate)
+        .def_rw("data_bitrate", &BusTiming::data_bitrate);
+
+    nb::class_<CANSocketOptions>(m, "CANSocketOptions")
+        .def(nb::init<>())
+        .def_rw("send_buffer_size", &CANSocketOptions::send_buffer_size)
+        .def_rw("receive_buffer_size", &CANSocketOptions::receive_buffer_size)
+        .def_rw("track_rx_overflow", &CANSocketOptions::track_rx_overflow)
+        .def_rw("bus_timing", &CANSocketOptions::bus_timing);
 
     // CAN Socket class
     nb::class_<CANSocket>(m, "CANSocket")
@@ -323,6 +458,10 @@ NB_MODULE(openarm_can, m) {
         .def("get_interface", &CANSocket::get_interface)
         .def("is_canfd_enabled", &CANSocket::is_canfd_enabled)
         .def("is_initialized", &CANSocket::is_initialized)
+        .def("get_rx_overflow_count", &CANSocket::get_rx_overflow_count)
+        .def("get_bus_load", &CANSocket::get_bus_load)
+        .def("set_frame_recorder", &CANSocket::set_frame_recorder, nb::arg("frame_recorder").none(),
+             nb::keep_alive<1, 2>())
         .def(
             "read_raw_frame",
             [](CANSocket& self, size_t buffer_size) {
@@ -347,6 +486,24 @@ NB_MODULE(openarm_can, m) {
         .def("write_canfd_frame", &CANSocket::write_canfd_frame, nb::arg("frame"))
         .def("read_canfd_frame", &CANSocket::read_canfd_frame, nb::arg("frame"));
 
+    nb::class_<DiscoveryOptions>(m, "DiscoveryOptions")
+        .def(nb::init<>())
+        .def_rw("window_us", &DiscoveryOptions::window_us)
+        .def_rw("retries", &DiscoveryOptions::retries);
+
+    nb::class_<DiscoveredMotorID>(m, "DiscoveredMotorID")
+        .def_ro("slave_id", &DiscoveredMotorID::slave_id)
+        .def_ro("master_id", &DiscoveredMotorID::master_id);
+
+    m.def(
+        "discover_motors",
+        [](CANSocket& socket, const std::vector<uint32_t>& slave_ids,
+           const DiscoveryOptions& options) {
+            return discover_motors(socket, slave_ids, options);
+        },
+        nb::arg("socket"), nb::arg("slave_ids"), nb::arg("options") = DiscoveryOptions(),
+        nb::call_guard<nb::gil_scoped_release>());
+
     // ============================================================================
     // LINUX CAN FRAME STRUCTURES
     // ============================================================================
@@ -395,11 +552,15 @@ NB_MODULE(openarm_can, m) {
         .def(nb::init<CANSocket&>(), nb::arg("can_socket"))
         .def("enable_all", &DMDeviceCollection::enable_all)
         .def("disable_all", &DMDeviceCollection::disable_all)
+        .def("clear_error_one", &DMDeviceCollection::clear_error_one, nb::arg("index"))
+        .def("clear_error_all", &DMDeviceCollection::clear_error_all)
         .def("set_zero_all", &DMDeviceCollection::set_zero_all)
         .def("refresh_all", &DMDeviceCollection::refresh_all)
         .def("set_callback_mode_all", &DMDeviceCollection::set_callback_mode_all,
              nb::arg("callback_mode"))
         .def("query_param_all", &DMDeviceCollection::query_param_all, nb::arg("rid"))
+        .def("set_fault_callback_all", &DMDeviceCollection::set_fault_callback_all,
+             nb::arg("fault_callback"))
         .def("set_control_mode_one", &DMDeviceCollection::set_control_mode_one, nb::arg("index"),
              nb::arg("mode"))
         .def("set_control_mode_all", &DMDeviceCollection::set_control_mode_all, nb::arg("mode"))
@@ -418,6 +579,9 @@ NB_MODULE(openarm_can, m) {
         .def("posforce_control_all", &DMDeviceCollection::posforce_control_all,
              nb::arg("posforce_params"))
         .def("get_motors", &DMDeviceCollection::get_motors)
+        .def("get_rtt_histogram", &DMDeviceCollection::get_rtt_histogram, nb::arg("index"),
+             nb::rv_policy::reference_internal)
+        .def("reset_rtt_histograms", &DMDeviceCollection::reset_rtt_histograms)
         .def("get_device_collection", &DMDeviceCollection::get_device_collection,
              nb::rv_policy::reference);
 
@@ -450,6 +614,107 @@ NB_MODULE(openarm_can, m) {
              nb::arg("kp") = 50.0, nb::arg("kd") = 1.0)
         .def("get_motor", &GripperComponent::get_motor, nb::rv_policy::reference_internal);
 
+    nb::enum_<CANBusState>(m, "CANBusState")
+        .value("ERROR_ACTIVE", CANBusState::ERROR_ACTIVE)
+        .value("ERROR_WARNING", CANBusState::ERROR_WARNING)
+        .value("ERROR_PASSIVE", CANBusState::ERROR_PASSIVE)
+        .value("BUS_OFF", CANBusState::BUS_OFF)
+        .value("STOPPED", CANBusState::STOPPED);
+
+    nb::enum_<CANErrorClass>(m, "CANErrorClass")
+        .value("TX_TIMEOUT", CANErrorClass::TX_TIMEOUT)
+        .value("LOST_ARBITRATION", CANErrorClass::LOST_ARBITRATION)
+        .value("CONTROLLER", CANErrorClass::CONTROLLER)
+        .value("PROTOCOL", CANErrorClass::PROTOCOL)
+        .value("TRANSCEIVER", CANErrorClass::TRANSCEIVER)
+        .value("NO_ACK", CANErrorClass::NO_ACK)
+        .value("BUS_OFF", CANErrorClass::BUS_OFF)
+        .value("BUS_ERROR", CANErrorClass::BUS_ERROR)
+        .value("RESTARTED", CANErrorClass::RESTARTED);
+
+    nb::class_<CANErrorEvent>(m, "CANErrorEvent")
+        .def_ro("classes", &CANErrorEvent::classes)
+        .def_ro("state", &CANErrorEvent::state)
+        .def_ro("rx_overflow", &CANErrorEvent::rx_overflow)
+        .def_ro("tx_overflow", &CANErrorEvent::tx_overflow)
+        .def_ro("has_error_counters", &CANErrorEvent::has_error_counters)
+        .def_ro("tx_error_counter", &CANErrorEvent::tx_error_counter)
+        .def_ro("rx_error_counter", &CANErrorEvent::rx_error_counter)
+        .def("has", &CANErrorEvent::has, nb::arg("error_class"));
+
+    nb::class_<CANInterfaceStatus>(m, "CANInterfaceStatus")
+        .def(nb::init<>())
+        .def_ro("up", &CANInterfaceStatus::up)
+        .def_ro("running", &CANInterfaceStatus::running)
+        .def_ro("is_can", &CANInterfaceStatus::is_can)
+        .def_ro("state", &CANInterfaceStatus::state)
+        .def_ro("has_error_counters", &CANInterfaceStatus::has_error_counters)
+        .def_ro("tx_error_counter", &CANInterfaceStatus::tx_error_counter)
+        .def_ro("rx_error_counter", &CANInterfaceStatus::rx_error_counter)
+        .def_ro("bitrate", &CANInterfaceStatus::bitrate)
+        .def_ro("sample_point", &CANInterfaceStatus::sample_point)
+        .def_ro("data_bitrate", &CANInterfaceStatus::data_bitrate)
+        .def_ro("restart_ms", &CANInterfaceStatus::restart_ms)
+        .def_ro("bus_errors", &CANInterfaceStatus::bus_errors)
+        .def_ro("error_warning", &CANInterfaceStatus::error_warning)
+        .def_ro("error_passive", &CANInterfaceStatus::error_passive)
+        .def_ro("bus_off", &CANInterfaceStatus::bus_off)
+        .def_ro("arbitration_lost", &CANInterfaceStatus::arbitration_lost)
+        .def_ro("restarts", &CANInterfaceStatus::restarts)
+        .def_ro("rx_packets", &CANInterfaceStatus::rx_packets)
+        .def_ro("tx_packets", &CANInterfaceStatus::tx_packets)
+        .def_ro("rx_errors", &CANInterfaceStatus::rx_errors)
+        .def_ro("tx_errors", &CANInterfaceStatus::tx_errors)
+        .def_ro("rx_dropped", &CANInterfaceStatus::rx_dropped)
+        .def_ro("tx_dropped", &CANInterfaceStatus::tx_dropped)
+        .def_ro("rx_over_errors", &CANInterfaceStatus::rx_over_errors);
+
+    m.def("read_can_interface_status", &read_can_interface_status, nb::arg("interface"));
+    m.def("restart_can_interface", &restart_can_interface, nb::arg("interface"));
+
+    nb::class_<CANInterfaceConfig>(m, "CANInterfaceConfig")
+        .def(nb::init<>())
+        .def_rw("bitrate", &CANInterfaceConfig::bitrate)
+        .def_rw("sample_point", &CANInterfaceConfig::sample_point)
+        .def_rw("sjw", &CANInterfaceConfig::sjw)
+        .def_rw("fd", &CANInterfaceConfig::fd)
+        .def_rw("data_bitrate", &CANInterfaceConfig::data_bitrate)
+        .def_rw("data_sample_point", &CANInterfaceConfig::data_sample_point)
+        .def_rw("data_sjw", &CANInterfaceConfig::data_sjw)
+        .def_rw("restart_ms", &CANInterfaceConfig::restart_ms)
+        .def_rw("up", &CANInterfaceConfig::up);
+
+    m.def("configure_can_interface", &configure_can_interface, nb::arg("interface"),
+          nb::arg("config"));
+    m.def("set_can_interface_up", &set_can_interface_up, nb::arg("interface"), nb::arg("up"));
+
+    nb::class_<CANInterfaceMonitor>(m, "CANInterfaceMonitor")
+        .def(nb::init<const std::vector<std::string>&, MetricsRegistry&, int>(),
+             nb::arg("interfaces"), nb::arg("registry"), nb::arg("interval_ms") = 1000,
+             nb::keep_alive<1, 3>())
+        .def("poll", &CANInterfaceMonitor::poll, nb::call_guard<nb::gil_scoped_release>())
+        .def(
+            "get_status",
+            [](const CANInterfaceMonitor& self,
+               size_t index) -> std::optional<CANInterfaceStatus> {
+                CANInterfaceStatus status;
+                if (!self.get_status(index, status)) return std::nullopt;
+                return status;
+            },
+            nb::arg("index"))
+        .def("get_poll_failures", &CANInterfaceMonitor::get_poll_failures);
+
+    nb::enum_<BusOffRecovery>(m, "BusOffRecovery")
+        .value("NONE", BusOffRecovery::NONE)
+        .value("RESTART", BusOffRecovery::RESTART);
+
+    nb::class_<EStopResult>(m, "EStopResult")
+        .def(nb::init<>())
+        .def_rw("frames_queued", &EStopResult::frames_queued)
+        .def_rw("frames_failed", &EStopResult::frames_failed)
+        .def_rw("frames_deferred", &EStopResult::frames_deferred)
+        .def_rw("latency_ns", &EStopResult::latency_ns);
+
     // OpenArm class (main high-level interface)
     nb::class_<OpenArm>(m, "OpenArm")
         .def(nb::init<const std::string&, bool>(), nb::arg("can_interface"),
@@ -466,9 +731,24 @@ NB_MODULE(openarm_can, m) {
              nb::rv_policy::reference)
         .def("enable_all", &OpenArm::enable_all)
         .def("disable_all", &OpenArm::disable_all)
+        .def("clear_error_all", &OpenArm::clear_error_all)
+        .def("estop", &OpenArm::estop)
+        .def_static("estop_all", &OpenArm::estop_all)
+        .def("get_estop_max_latency_ns", &OpenArm::get_estop_max_latency_ns)
         .def("set_zero_all", &OpenArm::set_zero_all)
         .def("refresh_all", &OpenArm::refresh_all)
         .def("recv_all", &OpenArm::recv_all, nb::arg("first_timeout_us") = 500)
+        .def("flush_tx", &OpenArm::flush_tx)
+        .def("get_cycle_stats", &OpenArm::get_cycle_stats, nb::rv_policy::reference_internal)
+        .def("reset_cycle_stats", &OpenArm::reset_cycle_stats)
+        .def("set_frame_recorder", &OpenArm::set_frame_recorder, nb::arg("frame_recorder").none(),
+             nb::keep_alive<1, 2>())
         .def("set_callback_mode_all", &OpenArm::set_callback_mode_all, nb::arg("callback_mode"))
-        .def("query_param_all", &OpenArm::query_param_all, nb::arg("rid"));
+        .def("query_param_all", &OpenArm::query_param_all, nb::arg("rid"))
+        .def("set_fault_callback_all", &OpenArm::set_fault_callback_all,
+             nb::arg("fault_callback"))
+        .def("set_bus_error_callback", &OpenArm::set_bus_error_callback, nb::arg("callback"))
+        .def("get_bus_state", &OpenArm::get_bus_state)
+        .def("set_bus_off_recovery", &OpenArm::set_bus_off_recovery, nb::arg("recovery"))
+        .def("get_bus_off_restarts", &OpenArm::get_bus_off_restarts);
 }
@@ -30,7 +30,8 @@ int run_can_configure(const std::vector<std::string>& interfaces, int bitrate, i
                       bool fd_mode, const std::string& sp, const std::string& dsp,
                       const std::string& dsjw, int restart_ms);
 
-int run_discover(const std::string& interface, int max_id, bool full_scan = false);
+// Scans the interfaces concurrently and prints one merged report
+int run_discover(const std::vector<std::string>& interfaces, int max_id, bool full_scan = false);
 
 int run_change_id(const std::string& interface, int current_id, int new_slave_id, int new_master_id,
                   bool save);
@@ -58,6 +59,9 @@ int run_clear_error(const std::string& interface, bool use_arm_ids,
 int run_monitor(const std::string& interface, bool use_arm_ids,
                 const std::vector<std::string>& custom_ids_str, int interval_ms, int duration_ms);
 
+int run_latency(const std::string& interface, bool use_arm_ids,
+                const std::vector<std::string>& custom_ids_str, int count, int interval_us);
+
 // ========================================================================
 // [ Shared Utilities ]
 // ========================================================================
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <cstdlib>
+#include <cmath>
 #include <iostream>
+#include <openarm/canbus/can_netlink.hpp>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -21,6 +23,17 @@
 
 namespace openarm::cli {
 
+namespace {
+// "0.75" as used by ip(8) -> 750, the kernel's tenths of a percent
+uint32_t parse_sample_point(const std::string& value) {
+    double sample_point = std::stod(value);
+    if (!(sample_point > 0.0 && sample_point < 1.0)) {
+        throw std::invalid_argument("sample point out of range");
+    }
+    return static_cast<uint32_t>(std::lround(sample_point * 1000.0));
+}
+}  // namespace
+
 int run_can_configure(const std::vector<std::string>& interfaces, int bitrate, int dbitrate,
                       bool fd_mode, const std::string& sample_point,
                       const std::string& dsample_point, const std::string& dsjw, int restart_ms) {
@@ -45,34 +58,29 @@ int run_can_configure(const std::vector<std::string>& interfaces, int bitrate, i
     std::cout << " Restart   : " << restart_ms << " ms\n";
     std::cout << "=========================================================\n\n";
 
+    openarm::canbus::CANInterfaceConfig config;
+    try {
+        config.bitrate = static_cast<uint32_t>(bitrate);
+        config.sample_point = parse_sample_point(sample_point);
+        config.fd = fd_mode;
+        config.data_bitrate = static_cast<uint32_t>(dbitrate);
+        config.data_sample_point = parse_sample_point(dsample_point);
+        config.data_sjw = static_cast<uint32_t>(std::stoul(dsjw));
+        config.restart_ms = static_cast<uint32_t>(restart_ms);
+    } catch (const std::exception&) {
+        std::cerr << "✗ Invalid sample point or DSJW." << std::endl;
+        return 1;
+    }
+
     int failed = 0;
 
     for (const auto& iface : target_interfaces) {
         std::cout << ">>> [" << iface << "] Applying..." << std::endl;
 
-        std::string cmd_down = "sudo ip link set " + iface + " down 2>/dev/null";
-        std::system(cmd_down.c_str());
-
-        std::string cmd_set = "sudo ip link set " + iface + " type can bitrate " +
-                              std::to_string(bitrate) + " sample-point " + sample_point +
-                              " restart-ms " + std::to_string(restart_ms);
-        if (fd_mode) {
-            cmd_set += " dbitrate " + std::to_string(dbitrate) + " fd on dsample-point " +
-                       dsample_point + " dsjw " + dsjw;
-        }
-
-        std::cout << "    " << cmd_set << std::endl;
-        int ret = std::system(cmd_set.c_str());
-        if (ret != 0) {
-            std::cerr << "✗ [" << iface << "] Failed to apply CAN parameters." << std::endl;
-            ++failed;
-            continue;
-        }
-
-        std::string cmd_up = "sudo ip link set " + iface + " up";
-        ret = std::system(cmd_up.c_str());
-        if (ret != 0) {
-            std::cerr << "✗ [" << iface << "] Failed to bring up interface." << std::endl;
+        try {
+            openarm::canbus::configure_can_interface(iface, config);
+        } catch (const openarm::canbus::CANNetlinkException& e) {
+            std::cerr << "✗ [" << iface << "] " << e.what() << std::endl;
             ++failed;
             continue;
         }
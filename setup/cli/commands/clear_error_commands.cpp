@@ -14,8 +14,11 @@
 
 #include <linux/can.h>
 
+#include <algorithm>
 #include <iostream>
 #include <openarm/canbus/can_socket.hpp>
+#include <openarm/damiao_motor/dm_motor.hpp>
+#include <openarm/damiao_motor/dm_motor_control.hpp>
 #include <string>
 #include <vector>
 
@@ -43,14 +46,15 @@ int run_clear_error(const std::string& interface, bool use_arm_ids,
         }
 
         for (int id : target_ids) {
-            struct can_frame frame;
-            frame.can_id = id;
-            frame.can_dlc = 8;
-
-            for (int i = 0; i < 7; i++) {
-                frame.data[i] = 0xFF;
-            }
-            frame.data[7] = 0xFB;
+            // The motor type and response ID do not affect the clear-error frame
+            openarm::damiao_motor::Motor motor(openarm::damiao_motor::MotorType::DM4310, id,
+                                               id + 0x10);
+            openarm::damiao_motor::CANPacket packet =
+                openarm::damiao_motor::CanPacketEncoder::create_clear_error_command(motor);
+            can_frame frame{};
+            frame.can_id = packet.send_can_id;
+            frame.can_dlc = static_cast<uint8_t>(packet.data.size());
+            std::copy(packet.data.begin(), packet.data.end(), frame.data);
 
             if (socket.write_can_frame(frame)) {
                 std::cout << "✓ Sent Clear Error command to Motor ID: " << format_hex_id(id)
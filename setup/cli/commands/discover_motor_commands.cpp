@@ -12,14 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <chrono>
-#include <cmath>
-#include <cstdlib>
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <map>
-#include <openarm/can/socket/openarm.hpp>
-#include <openarm/damiao_motor/dm_motor_constants.hpp>
+#include <mutex>
+#include <openarm/canbus/can_netlink.hpp>
+#include <openarm/canbus/can_socket.hpp>
+#include <openarm/damiao_motor/dm_motor_discovery.hpp>
 #include <set>
 #include <sstream>
 #include <thread>
@@ -48,12 +48,14 @@ static const std::map<int, BaudSetting> ALL_BAUDRATE_MAP = {
 static const std::vector<int> DEFAULT_BAUD_CODES = {4, 9, 10, 11};  // 1M, 5M, 8M, 10M
 
 struct DiscoveredMotor {
+    std::string interface;
     uint32_t send_id;
     uint32_t recv_id;
     int baud_code;
     std::string baud_label;
 
     bool operator<(const DiscoveredMotor& other) const {
+        if (interface != other.interface) return interface < other.interface;
         if (send_id != other.send_id) return send_id < other.send_id;
         if (recv_id != other.recv_id) return recv_id < other.recv_id;
         return baud_code < other.baud_code;
@@ -77,25 +79,99 @@ void print_progress(int current, int total, const std::string& info) {
     std::cout << "] " << int(progress * 100.0) << "% | " << info << std::flush;
 }
 
-// Helper: Reconfigure CAN interface baudrate
-bool reconfigure_can_interface(const std::string& iface, int br, int dbr) {
-    std::string cmd = "sudo ip link set " + iface + " type can bitrate " + std::to_string(br) +
-                      " sample-point 0.75";
+// Progress shared by the per-interface scan threads; also serializes output
+class ScanProgress {
+public:
+    explicit ScanProgress(int total) : total_(total) {}
 
-    if (br != dbr) {
-        cmd += " dbitrate " + std::to_string(dbr) + " fd on dsample-point 0.60 dsjw 1";
+    void start(const std::string& info) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        print_progress(done_, total_, info + "...");
+    }
+    void finish() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++done_;
+    }
+    void error(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cerr << "\n" << message << std::endl;
     }
-    cmd += " restart-ms 100 2>/dev/null";
 
-    (void)system(("sudo ip link set " + iface + " down 2>/dev/null").c_str());
-    int res = system(cmd.c_str());
-    (void)system(("sudo ip link set " + iface + " up 2>/dev/null").c_str());
+private:
+    std::mutex mutex_;
+    int done_ = 0;
+    int total_;
+};
 
-    return (res == 0);
+// Helper: Reconfigure CAN interface baudrate
+bool reconfigure_can_interface(const std::string& iface, int br, int dbr, ScanProgress& progress) {
+    openarm::canbus::CANInterfaceConfig config;
+    config.bitrate = br;
+    config.sample_point = 750;
+    config.fd = (br != dbr);
+    config.data_bitrate = dbr;
+    config.data_sample_point = 600;
+    config.data_sjw = 1;
+    config.restart_ms = 100;
+    try {
+        openarm::canbus::configure_can_interface(iface, config);
+    } catch (const openarm::canbus::CANNetlinkException& e) {
+        progress.error(e.what());
+        return false;
+    }
+    return true;
 }
 
-int run_discover(const std::string& interface, int max_id, bool full_scan) {
-    std::set<DiscoveredMotor> found_motors;
+struct InterfaceScan {
+    std::set<DiscoveredMotor> motors;
+    bool restored = false;
+};
+
+// Sweep the baudrates on one interface, then restore it to can_configure
+// defaults (1 Mbps / 5 Mbps FD). Runs on its own thread per interface.
+InterfaceScan scan_interface(const std::string& interface, const std::vector<int>& baud_codes,
+                             const std::vector<uint32_t>& slave_ids, ScanProgress& progress) {
+    InterfaceScan scan;
+    for (int b : baud_codes) {
+        const auto& setting = ALL_BAUDRATE_MAP.at(b);
+        progress.start(interface + ": Testing " + setting.label);
+
+        if (reconfigure_can_interface(interface, setting.bitrate, setting.dbitrate, progress)) {
+            // One socket per baud; all IDs are queried at once and only the
+            // silent ones again
+            try {
+                openarm::canbus::CANSocket socket(interface, setting.bitrate != setting.dbitrate);
+                for (const auto& motor :
+                     openarm::damiao_motor::discover_motors(socket, slave_ids)) {
+                    scan.motors.insert(
+                        {interface, motor.slave_id, motor.master_id, b, setting.label});
+                }
+            } catch (const openarm::canbus::CANSocketException& e) {
+                progress.error(e.what());
+            }
+        }
+        progress.finish();
+    }
+
+    try {
+        // The CANInterfaceConfig defaults are the can_configure defaults
+        openarm::canbus::configure_can_interface(interface, {});
+        scan.restored = true;
+    } catch (const openarm::canbus::CANNetlinkException& e) {
+        progress.error(e.what());
+    }
+    return scan;
+}
+
+int run_discover(const std::vector<std::string>& requested_interfaces, int max_id,
+                 bool full_scan) {
+    // Two threads on one interface would reconfigure it under each other
+    std::vector<std::string> interfaces;
+    for (const auto& interface : requested_interfaces) {
+        if (std::find(interfaces.begin(), interfaces.end(), interface) == interfaces.end()) {
+            interfaces.push_back(interface);
+        }
+    }
 
     // Select baudrates to scan
     std::vector<int> baud_codes;
@@ -104,66 +180,38 @@ int run_discover(const std::string& interface, int max_id, bool full_scan) {
     } else {
         baud_codes = DEFAULT_BAUD_CODES;
     }
-    const int total_bauds = static_cast<int>(baud_codes.size());
+
+    std::vector<uint32_t> slave_ids;
+    for (int id = 1; id <= max_id; ++id) slave_ids.push_back(static_cast<uint32_t>(id));
 
     std::cout << "=========================================================\n";
     std::cout << " OPENARM DEEP DISCOVERY MODE\n";
     std::cout << "---------------------------------------------------------\n";
     std::cout << " Mode: " << (full_scan ? "Full scan (12 baudrates)" : "Fast scan (1M/5M/8M/10M)")
               << "\n";
+    std::cout << " Interfaces:";
+    for (const auto& interface : interfaces) std::cout << " " << interface;
+    std::cout << "\n";
     std::cout << " [Timing] SP: 0.75 / DSP: 0.60 / DSJW: 1\n";
     std::cout << " Scanning Range: 0x01 to " << format_hex_id(max_id) << "\n";
     std::cout << "=========================================================\n\n";
 
-    for (int bi = 0; bi < total_bauds; ++bi) {
-        int b = baud_codes[bi];
-        auto setting = ALL_BAUDRATE_MAP.at(b);
-        print_progress(bi, total_bauds, "Testing " + setting.label + "...");
-
-        if (!reconfigure_can_interface(interface, setting.bitrate, setting.dbitrate)) continue;
-
-        // Wait for interface to stabilize
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-
-        for (int id = 1; id <= max_id; ++id) {
-            uint32_t recv_candidates[2] = {(uint32_t)(id + 0x10), 0x00};
-
-            for (uint32_t rid : recv_candidates) {
-                try {
-                    openarm::can::socket::OpenArm openarm(interface,
-                                                          (setting.bitrate != setting.dbitrate));
-
-                    openarm.init_arm_motors({openarm::damiao_motor::MotorType::DM4310},
-                                            {(uint32_t)id}, {rid});
-                    openarm.set_callback_mode_all(openarm::damiao_motor::CallbackMode::PARAM);
-
-                    bool detected = false;
-                    for (int retry = 0; retry < 2; ++retry) {
-                        openarm.get_arm().query_param_all((int)openarm::damiao_motor::RID::MST_ID);
-
-                        for (int k = 0; k < 2; ++k) {
-                            std::this_thread::sleep_for(std::chrono::milliseconds(15));
-                            openarm.recv_all();
-                        }
-
-                        double val = openarm.get_arm().get_motor(0).get_param(
-                            (int)openarm::damiao_motor::RID::MST_ID);
-                        if (std::isfinite(val) && val != -1.0) {
-                            detected = true;
-                            break;
-                        }
-                    }
-
-                    if (detected) {
-                        found_motors.insert({(uint32_t)id, rid, b, setting.label});
-                    }
-                } catch (...) {
-                }
-            }
-        }
+    // Each bus is scanned concurrently, so the total is the slowest sweep
+    const int total_steps = static_cast<int>(baud_codes.size() * interfaces.size());
+    ScanProgress progress(total_steps);
+    std::vector<InterfaceScan> scans(interfaces.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < interfaces.size(); ++i) {
+        threads.emplace_back([&, i] {
+            scans[i] = scan_interface(interfaces[i], baud_codes, slave_ids, progress);
+        });
     }
+    for (auto& thread : threads) thread.join();
+
+    print_progress(total_steps, total_steps, "Scan Complete!                      \n\n");
 
-    print_progress(total_bauds, total_bauds, "Scan Complete!            \n\n");
+    std::set<DiscoveredMotor> found_motors;
+    for (const auto& scan : scans) found_motors.insert(scan.motors.begin(), scan.motors.end());
 
     if (found_motors.empty()) {
         std::cout << "[!] No motors detected. Check wiring and power.\n";
@@ -171,34 +219,29 @@ int run_discover(const std::string& interface, int max_id, bool full_scan) {
         std::cout << "=========================================================\n";
         std::cout << " DISCOVERY SUMMARY (Total: " << found_motors.size() << " motors found)\n";
         std::cout << "---------------------------------------------------------\n";
-        std::cout << std::left << std::setw(12) << "Send ID" << std::setw(12) << "Recv ID"
-                  << "Internal Baudrate Setting\n";
+        std::cout << std::left << std::setw(12) << "Interface" << std::setw(12) << "Send ID"
+                  << std::setw(12) << "Recv ID" << "Internal Baudrate Setting\n";
         std::cout << "---------------------------------------------------------\n";
 
         for (const auto& m : found_motors) {
-            std::cout << std::left << std::setw(12) << format_hex_id(m.send_id) << std::setw(12)
-                      << format_hex_id(m.recv_id) << m.baud_label << " (Code: " << m.baud_code
-                      << ")\n";
+            std::cout << std::left << std::setw(12) << m.interface << std::setw(12)
+                      << format_hex_id(m.send_id) << std::setw(12) << format_hex_id(m.recv_id)
+                      << m.baud_label << " (Code: " << m.baud_code << ")\n";
         }
         std::cout << "=========================================================\n";
     }
 
-    // Restore interface to can_configure defaults (1 Mbps / 5 Mbps FD)
     std::cout << "\n=========================================================\n";
-    std::cout << " RESTORING INTERFACE\n";
+    std::cout << " RESTORING INTERFACES\n";
     std::cout << "---------------------------------------------------------\n";
-    std::cout << " Restoring "
-              << interface << " to default: 1 Mbps / 5 Mbps FD (SP:0.75 DSP:0.75 DSJW:2)\n";
-    (void)std::system(("sudo ip link set " + interface + " down 2>/dev/null").c_str());
-    std::string cmd_restore = "sudo ip link set " + interface +
-                              " type can bitrate 1000000 sample-point 0.75"
-                              " dbitrate 5000000 fd on dsample-point 0.75 dsjw 2 restart-ms 100";
-    int restore_ret = std::system(cmd_restore.c_str());
-    (void)std::system(("sudo ip link set " + interface + " up 2>/dev/null").c_str());
-    if (restore_ret == 0) {
-        std::cout << "✓ " << interface << " is ready: 1 Mbps / 5 Mbps FD\n";
-    } else {
-        std::cerr << "✗ Failed to restore " << interface << ". Run 'can_configure' manually.\n";
+    std::cout << " Default: 1 Mbps / 5 Mbps FD (SP:0.75 DSP:0.75 DSJW:2)\n";
+    for (size_t i = 0; i < interfaces.size(); ++i) {
+        if (scans[i].restored) {
+            std::cout << "✓ " << interfaces[i] << " is ready: 1 Mbps / 5 Mbps FD\n";
+        } else {
+            std::cerr << "✗ Failed to restore " << interfaces[i]
+                      << ". Run 'can_configure' manually.\n";
+        }
     }
     std::cout << "=========================================================\n";
 
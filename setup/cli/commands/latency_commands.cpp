@@ -0,0 +1,97 @@
+// Copyright 2026 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/damiao_motor/dm_motor_constants.hpp>
+#include <thread>
+#include <vector>
+
+#include "cli.hpp"
+
+namespace openarm::cli {
+
+/**
+ * @brief Measures per-motor command-to-reply latency.
+ * Sends refresh requests (which do not enable the motors) and dumps each
+ * motor's round-trip histogram.
+ */
+int run_latency(const std::string& interface, bool use_arm_ids,
+                const std::vector<std::string>& custom_ids_str, int count, int interval_us) {
+    std::vector<uint32_t> send_ids;
+    if (use_arm_ids) {
+        for (uint32_t i = 1; i <= 8; ++i) send_ids.push_back(i);
+    }
+    for (const auto& id_str : custom_ids_str) {
+        try {
+            send_ids.push_back(std::stoul(id_str, nullptr, 0));
+        } catch (...) {
+            std::cerr << "✗ Error: Invalid ID format provided: '" << id_str << "'\n";
+            return 1;
+        }
+    }
+
+    if (send_ids.empty()) {
+        std::cerr << "✗ Error: No target IDs specified. Use --arm or --id.\n";
+        return 1;
+    }
+
+    try {
+        openarm::can::socket::OpenArm openarm(interface, true);
+        std::vector<openarm::damiao_motor::MotorType> motor_types(
+            send_ids.size(), openarm::damiao_motor::MotorType::DM4310);
+        std::vector<uint32_t> recv_ids;
+        for (auto id : send_ids) recv_ids.push_back(id + 0x10);
+        openarm.init_arm_motors(motor_types, send_ids, recv_ids);
+        openarm.set_callback_mode_all(openarm::damiao_motor::CallbackMode::STATE);
+
+        std::cout << ">>> Measuring round trips on " << interface << " (" << count
+                  << " requests per motor)..." << std::endl;
+        for (int i = 0; i < count; ++i) {
+            openarm.refresh_all();
+            openarm.recv_all(2000);
+            std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+            openarm.recv_all(0);
+        }
+
+        auto& arm = openarm.get_arm();
+        std::cout << "\n ID   | Replies | p50 (us) | p90 (us) | p99 (us) | p99.9 (us) | max (us)\n";
+        std::cout << "------+---------+----------+----------+----------+------------+---------\n";
+        bool all_replied = true;
+        for (size_t i = 0; i < send_ids.size(); ++i) {
+            const auto& histogram = arm.get_rtt_histogram(i);
+            if (histogram.count() == 0) all_replied = false;
+            std::cout << " " << format_hex_id(send_ids[i]) << " | " << std::setw(7)
+                      << histogram.count() << std::fixed << std::setprecision(1);
+            for (double percent : {50.0, 90.0, 99.0}) {
+                std::cout << " | " << std::setw(8) << histogram.percentile(percent) / 1000.0;
+            }
+            std::cout << " | " << std::setw(10) << histogram.percentile(99.9) / 1000.0 << " | "
+                      << std::setw(8) << histogram.max() / 1000.0 << "\n";
+        }
+
+        if (!all_replied) {
+            std::cerr << "✗ Some motors never replied. Check wiring, power, and CAN IDs.\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "✗ System Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace openarm::cli
@@ -143,9 +143,14 @@ int main(int argc, char** argv) {
         ->default_val("16");
     discover->add_flag("--full-scan", disc_full_scan,
                        "Scan all 12 baudrates (default: 1M/5M/8M/10M only)");
+    static std::vector<std::string> disc_interfaces;
+    discover->add_option("--interfaces", disc_interfaces,
+                         "Scan these interfaces concurrently instead of -i (e.g. can0,can1)");
 
     discover->callback([&]() {
-        int result = openarm::cli::run_discover(global_iface, disc_max_id, disc_full_scan);
+        std::vector<std::string> target_ifaces = expand_ids(disc_interfaces);
+        if (target_ifaces.empty()) target_ifaces = {global_iface};
+        int result = openarm::cli::run_discover(target_ifaces, disc_max_id, disc_full_scan);
         if (result != 0) {
             throw CLI::RuntimeError("discover failed.", result);
         }
@@ -362,6 +367,32 @@ int main(int argc, char** argv) {
         }
     });
 
+    // --- latency: Per-motor round-trip histograms ---
+    auto* latency =
+        app.add_subcommand("latency", "Per-motor round-trip latency (default: arm IDs 1-8)")
+            ->group("[ Operation & Debug ]");
+    static bool lat_arm = true;
+    static std::vector<std::string> lat_ids;
+    static int lat_count = 1000;
+    static int lat_interval = 1000;  // us
+
+    latency->add_flag("-a,--arm,!--no-arm", lat_arm, "Measure all arm motors (IDs 1-8) [default]")
+        ->default_val("true");
+    latency->add_option("--id", lat_ids, "Target motor IDs (e.g. --id 1,2,3  or  --id 1 2 3)");
+    latency->add_option("-n,--count", lat_count, "Requests per motor")->default_val("1000");
+    latency->add_option("--interval-us", lat_interval, "Pause between requests in microseconds")
+        ->default_val("1000");
+
+    latency->callback([&]() {
+        auto ids = expand_ids(lat_ids);
+        if (!ids.empty()) lat_arm = false;  // --id overrides --arm
+        int result =
+            openarm::cli::run_latency(global_iface, lat_arm, ids, lat_count, lat_interval);
+        if (result != 0) {
+            throw CLI::RuntimeError("latency failed.", result);
+        }
+    });
+
     // ========================================================================
     // Execution - Parse arguments and dispatch subcommands
     // ========================================================================
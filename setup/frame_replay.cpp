@@ -0,0 +1,156 @@
+// Copyright 2026 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replays a recorded frame log through the motor device stack, either at
+// the recorded timing or as fast as possible to measure decode throughput.
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/frame_replay.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name
+              << " <log> [--speed X | --afap] [--motors N] [--recv-offset HEX] [--include-tx]\n"
+                 "       [--repeat N] [-fd]"
+              << std::endl;
+    std::cout << "Reads a FrameRecorder binary log or a candump -l log and decodes it with\n"
+                 "DM4310 motors using send IDs 1..N and recv IDs send ID + offset (0x10).\n"
+                 "--speed scales the recorded timing; --afap dispatches as fast as possible."
+              << std::endl;
+    std::cout << "Example: " << program_name << " session.log --afap --repeat 100" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    openarm::canbus::ReplayOptions options;
+    int motor_count = 8;
+    uint32_t recv_offset = 0x10;
+    int repeat = 1;
+    bool force_fd = false;
+
+    for (int arg_idx = 1; arg_idx < argc; ++arg_idx) {
+        std::string arg = argv[arg_idx];
+        bool has_value = arg_idx + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "--speed" && has_value) {
+            options.speed = std::stod(argv[++arg_idx]);
+        } else if (arg == "--afap") {
+            options.speed = 0;
+        } else if (arg == "--motors" && has_value) {
+            motor_count = std::stoi(argv[++arg_idx]);
+        } else if (arg == "--recv-offset" && has_value) {
+            recv_offset = std::stoul(argv[++arg_idx], nullptr, 0);
+        } else if (arg == "--include-tx") {
+            options.include_tx = true;
+        } else if (arg == "--repeat" && has_value) {
+            repeat = std::stoi(argv[++arg_idx]);
+        } else if (arg == "-fd") {
+            force_fd = true;
+        } else if (!arg.empty() && arg[0] != '-' && path.empty()) {
+            path = arg;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty() || motor_count < 1 || repeat < 1 || options.speed < 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        std::vector<openarm::canbus::RecordedFrame> frames = openarm::canbus::read_frame_log(path);
+        bool use_fd = force_fd;
+        for (const auto& frame : frames) use_fd = use_fd || frame.is_fd;
+
+        // The transport only names the bus; frames come from the log
+        openarm::can::socket::OpenArm openarm(
+            std::make_unique<openarm::canbus::LoopbackTransport>(use_fd, "replay"));
+        std::vector<openarm::damiao_motor::MotorType> motor_types(
+            motor_count, openarm::damiao_motor::MotorType::DM4310);
+        std::vector<uint32_t> send_ids;
+        std::vector<uint32_t> recv_ids;
+        for (int i = 1; i <= motor_count; ++i) {
+            send_ids.push_back(i);
+            recv_ids.push_back(i + recv_offset);
+        }
+        openarm.init_arm_motors(motor_types, send_ids, recv_ids);
+        openarm.set_callback_mode_all(openarm::damiao_motor::CallbackMode::STATE);
+
+        auto& collection = openarm.get_master_can_device_collection();
+        std::cout << "Replaying " << frames.size() << " frame(s) from " << path
+                  << (use_fd ? " (CAN-FD)" : "") << ", ";
+        if (options.speed > 0) {
+            std::cout << "speed x" << options.speed << std::endl;
+        } else {
+            std::cout << "as fast as possible" << std::endl;
+        }
+
+        openarm::canbus::ReplayStats total;
+        for (int i = 0; i < repeat; ++i) {
+            openarm::canbus::ReplayStats stats =
+                openarm::canbus::replay_frames(frames, collection, options);
+            total.frames_dispatched += stats.frames_dispatched;
+            total.frames_skipped += stats.frames_skipped;
+            total.elapsed_s += stats.elapsed_s;
+            total.max_lag_ns = std::max(total.max_lag_ns, stats.max_lag_ns);
+        }
+
+        std::cout << "Dispatched " << total.frames_dispatched << " frame(s), skipped "
+                  << total.frames_skipped << ", unknown IDs " << collection.get_unknown_id_frames()
+                  << std::endl;
+        std::cout << std::fixed << std::setprecision(3) << "Elapsed " << total.elapsed_s << " s";
+        if (total.frames_dispatched > 0 && total.elapsed_s > 0) {
+            std::cout << ", " << std::setprecision(1)
+                      << total.elapsed_s * 1e9 / total.frames_dispatched << " ns/frame, "
+                      << std::setprecision(0) << total.frames_dispatched / total.elapsed_s
+                      << " frames/s";
+        }
+        if (options.speed > 0) {
+            std::cout << ", max lag " << std::setprecision(1) << total.max_lag_ns / 1000.0 << " us";
+        }
+        std::cout << std::endl;
+
+        std::cout << "\n ID(S/R) | Frames | Decode errors | Position (rad) | Velocity (rad/s) | "
+                     "Torque (Nm)"
+                  << std::endl;
+        for (const auto& [recv_id, device] : collection.get_devices()) {
+            auto dm_device =
+                std::dynamic_pointer_cast<openarm::damiao_motor::DMCANDevice>(device);
+            if (!dm_device) continue;
+            const auto& motor = dm_device->get_motor();
+            std::cout << " " << std::setw(2) << std::hex << motor.get_send_can_id() << "/"
+                      << std::setw(2) << motor.get_recv_can_id() << std::dec << "   | "
+                      << std::setw(6) << device->get_rx_frames() << " | " << std::setw(13)
+                      << device->get_decode_errors() << " | " << std::setw(14)
+                      << std::setprecision(4) << motor.get_position() << " | " << std::setw(16)
+                      << motor.get_velocity() << " | " << std::setw(11) << motor.get_torque()
+                      << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
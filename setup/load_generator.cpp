@@ -0,0 +1,421 @@
+// Copyright 2026 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Drives N simulated arms x M simulated motors at a target rate and reports
+// the achieved cycle rate, frame loss, cycle latency and CPU usage.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/can_interface_monitor.hpp>
+#include <openarm/canbus/can_socket.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/canbus/metrics.hpp>
+#include <openarm/canbus/trace.hpp>
+#include <openarm/damiao_motor/dm_motor_simulator.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using openarm::damiao_motor::MotorType;
+
+// Send IDs stay below the recv offset, recv IDs below the +0x100 mode IDs
+constexpr uint32_t kRecvIdOffset = 0x80;
+constexpr uint32_t kMaxMotorsPerBus = kRecvIdOffset - 1;
+
+std::atomic<bool> keep_running{true};
+void signal_handler(int /*signum*/) { keep_running = false; }
+
+struct Options {
+    std::vector<std::string> interfaces = {"vcan0"};
+    int arms = 1;
+    int motors = 8;
+    double rate_hz = 1000.0;
+    double duration_s = 10.0;
+    int reply_latency_us = 0;
+    bool use_fd = false;
+    bool loopback = false;
+    std::string metrics_textfile;
+    std::string trace_path;
+    openarm::canbus::BusTiming bus_timing;
+};
+
+// Motors of all arms and the simulator emulating them on one bus
+struct Bus {
+    std::string interface;
+    std::unique_ptr<openarm::canbus::CANTransport> motor_side;
+    std::unique_ptr<openarm::damiao_motor::DMMotorSimulator> simulator;
+    uint32_t next_send_id = 1;
+};
+
+struct ArmResult {
+    std::string interface;
+    uint64_t cycles = 0;
+    uint64_t incomplete_cycles = 0;
+    uint64_t frames_sent = 0;
+    uint64_t replies_received = 0;
+    double elapsed_s = 0;
+    double cpu_s = 0;
+    std::vector<double> latencies_us;
+};
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name
+              << " [--interfaces vcan0,vcan1] [--arms N] [--motors M] [--rate-hz HZ]\n"
+                 "       [--duration-s S] [--latency-us US] [-fd] [--loopback]\n"
+                 "       [--metrics-textfile PATH] [--trace PATH] [--bitrate BPS] [--dbitrate BPS]"
+              << std::endl;
+    std::cout << "Arms are spread round-robin over the interfaces; --loopback uses an\n"
+                 "in-process bus per arm instead of SocketCAN. --metrics-textfile writes\n"
+                 "bus and motor counters for the node_exporter textfile collector every second,\n"
+                 "plus the kernel state and statistics of SocketCAN interfaces.\n"
+                 "--trace writes a Chrome/Perfetto JSON trace of the send and receive phases.\n"
+                 "--bitrate and --dbitrate only size the bus load estimate."
+              << std::endl;
+    std::cout << "Example: " << program_name << " --interfaces vcan0,vcan1 --arms 4 --rate-hz 1000"
+              << std::endl;
+}
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+double thread_cpu_seconds() {
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+double process_cpu_seconds() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+uint64_t count_replies(openarm::can::socket::OpenArm& openarm) {
+    uint64_t replies = 0;
+    for (const auto& [id, device] : openarm.get_master_can_device_collection().get_devices()) {
+        replies += device->get_rx_frames();
+    }
+    return replies;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void run_arm(openarm::can::socket::OpenArm& openarm, const Options& options, ArmResult& result) {
+    const auto period = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / options.rate_hz));
+    const size_t motor_count = openarm.get_arm().get_motors().size();
+    std::vector<openarm::damiao_motor::MITParam> params(motor_count, {10, 0.5, 0, 0, 0});
+
+    // Collect every enable reply so none is counted as a cycle reply
+    openarm.enable_all();
+    const auto enable_deadline = Clock::now() + std::chrono::milliseconds(100);
+    while (count_replies(openarm) < motor_count && Clock::now() < enable_deadline) {
+        openarm.recv_all(1000);
+    }
+
+    const double cpu_start = thread_cpu_seconds();
+    const uint64_t replies_start = count_replies(openarm);
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double>(options.duration_s));
+    auto next_wakeup = start;
+
+    while (keep_running && Clock::now() < end) {
+        const uint64_t replies_before = count_replies(openarm);
+        const auto t_send = Clock::now();
+        openarm.get_arm().mit_control_all(params);
+        result.frames_sent += motor_count;
+
+        // Wait for this cycle's replies until the next cycle is due
+        const auto deadline = t_send + period;
+        uint64_t received = 0;
+        auto now = t_send;
+        while (received < motor_count && now < deadline) {
+            auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+            openarm.recv_all(static_cast<int>(std::max<int64_t>(1, remaining.count())));
+            received = count_replies(openarm) - replies_before;
+            now = Clock::now();
+        }
+        if (received >= motor_count) {
+            result.latencies_us.push_back(
+                std::chrono::duration<double, std::micro>(now - t_send).count());
+        } else {
+            ++result.incomplete_cycles;
+        }
+        ++result.cycles;
+
+        next_wakeup += period;
+        if (next_wakeup < now) next_wakeup = now;
+        std::this_thread::sleep_until(next_wakeup);
+    }
+
+    // Late replies still count as received, not lost
+    openarm.recv_all(10000);
+    result.elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+    result.replies_received = count_replies(openarm) - replies_start;
+    result.cpu_s = thread_cpu_seconds() - cpu_start;
+    openarm.disable_all();
+    openarm.recv_all(1000);
+}
+
+void print_report(const Options& options, std::vector<ArmResult>& results, double wall_s,
+                  double process_cpu_s) {
+    std::cout << "\n"
+              << options.arms << " arm(s) x " << options.motors << " motor(s), target "
+              << options.rate_hz << " Hz" << (options.use_fd ? ", CAN-FD" : "") << "\n\n";
+    std::cout << " Arm | Interface |  Rate (Hz) | Loss (%) | Late | p50 (us) | p90 (us) | "
+                 "p99 (us) | p99.9 (us) | max (us)\n";
+    std::cout << "-----+-----------+------------+----------+------+----------+----------+-"
+                 "---------+------------+---------\n";
+
+    uint64_t total_sent = 0;
+    uint64_t total_received = 0;
+    double host_cpu_s = 0;
+    std::vector<double> all_latencies;
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto& result = results[i];
+        std::sort(result.latencies_us.begin(), result.latencies_us.end());
+        all_latencies.insert(all_latencies.end(), result.latencies_us.begin(),
+                             result.latencies_us.end());
+        total_sent += result.frames_sent;
+        total_received += result.replies_received;
+        host_cpu_s += result.cpu_s;
+
+        double loss = result.frames_sent == 0
+                          ? 0.0
+                          : 100.0 * (1.0 - static_cast<double>(result.replies_received) /
+                                               result.frames_sent);
+        const auto& latencies = result.latencies_us;
+        std::cout << std::fixed << std::setprecision(1) << std::setw(4) << i << " | "
+                  << std::setw(9) << result.interface << " | " << std::setw(10)
+                  << result.cycles / result.elapsed_s << " | " << std::setprecision(3)
+                  << std::setw(8) << std::max(0.0, loss) << " | " << std::setw(4)
+                  << result.incomplete_cycles << " | " << std::setprecision(1) << std::setw(8)
+                  << percentile(latencies, 0.5) << " | " << std::setw(8)
+                  << percentile(latencies, 0.9) << " | " << std::setw(8)
+                  << percentile(latencies, 0.99) << " | " << std::setw(10)
+                  << percentile(latencies, 0.999) << " | " << std::setw(8)
+                  << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+    }
+    std::sort(all_latencies.begin(), all_latencies.end());
+
+    std::cout << "\nFrames: " << total_sent << " sent, " << total_received << " replies ("
+              << std::setprecision(3)
+              << (total_sent == 0 ? 0.0
+                                  : 100.0 * (total_sent - std::min(total_sent, total_received)) /
+                                        total_sent)
+              << "% lost)\n";
+    std::cout << "Latency (all arms): p50 " << std::setprecision(1)
+              << percentile(all_latencies, 0.5) << " us, p99 " << percentile(all_latencies, 0.99)
+              << " us, p99.9 " << percentile(all_latencies, 0.999) << " us\n";
+    std::cout << "CPU (% of one core): host threads " << 100.0 * host_cpu_s / wall_s
+              << ", process total " << 100.0 * process_cpu_s / wall_s << " (includes simulators)"
+              << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::signal(SIGINT, signal_handler);
+
+    Options options;
+    for (int arg_idx = 1; arg_idx < argc; ++arg_idx) {
+        std::string arg = argv[arg_idx];
+        bool has_value = arg_idx + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "-fd") {
+            options.use_fd = true;
+        } else if (arg == "--loopback") {
+            options.loopback = true;
+        } else if (arg == "--interfaces" && has_value) {
+            options.interfaces = split(argv[++arg_idx]);
+        } else if (arg == "--arms" && has_value) {
+            options.arms = std::stoi(argv[++arg_idx]);
+        } else if (arg == "--motors" && has_value) {
+            options.motors = std::stoi(argv[++arg_idx]);
+        } else if (arg == "--rate-hz" && has_value) {
+            options.rate_hz = std::stod(argv[++arg_idx]);
+        } else if (arg == "--duration-s" && has_value) {
+            options.duration_s = std::stod(argv[++arg_idx]);
+        } else if (arg == "--latency-us" && has_value) {
+            options.reply_latency_us = std::stoi(argv[++arg_idx]);
+        } else if (arg == "--metrics-textfile" && has_value) {
+            options.metrics_textfile = argv[++arg_idx];
+        } else if (arg == "--trace" && has_value) {
+            options.trace_path = argv[++arg_idx];
+        } else if (arg == "--bitrate" && has_value) {
+            options.bus_timing.bitrate = std::stoul(argv[++arg_idx]);
+        } else if (arg == "--dbitrate" && has_value) {
+            options.bus_timing.data_bitrate = std::stoul(argv[++arg_idx]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.arms < 1 || options.motors < 1 || options.rate_hz <= 0 ||
+        options.interfaces.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        // In loopback mode every arm gets a private bus; otherwise arms share
+        // the interfaces round-robin with one simulator per interface.
+        size_t bus_count = options.loopback ? options.arms : options.interfaces.size();
+        std::vector<Bus> buses(bus_count);
+        std::vector<std::unique_ptr<openarm::can::socket::OpenArm>> arms;
+        std::vector<ArmResult> results(options.arms);
+
+        openarm::canbus::CANSocketOptions socket_options;
+        socket_options.bus_timing = options.bus_timing;
+        for (size_t i = 0; i < bus_count; ++i) {
+            Bus& bus = buses[i];
+            if (options.loopback) {
+                bus.interface = "loopback" + std::to_string(i);
+                bus.motor_side = std::make_unique<openarm::canbus::LoopbackTransport>(
+                    options.use_fd, bus.interface);
+            } else {
+                bus.interface = options.interfaces[i];
+                bus.motor_side = std::make_unique<openarm::canbus::CANSocket>(
+                    bus.interface, options.use_fd, socket_options);
+            }
+            bus.simulator =
+                std::make_unique<openarm::damiao_motor::DMMotorSimulator>(*bus.motor_side);
+            bus.simulator->set_reply_latency_us(options.reply_latency_us);
+        }
+
+        for (int arm_idx = 0; arm_idx < options.arms; ++arm_idx) {
+            Bus& bus = buses[arm_idx % bus_count];
+            if (bus.next_send_id + options.motors - 1 > kMaxMotorsPerBus) {
+                std::cerr << "Error: more than " << kMaxMotorsPerBus << " motors on "
+                          << bus.interface << std::endl;
+                return 1;
+            }
+
+            std::unique_ptr<openarm::can::socket::OpenArm> openarm;
+            if (options.loopback) {
+                auto host = std::make_unique<openarm::canbus::LoopbackTransport>(options.use_fd,
+                                                                                 bus.interface);
+                openarm::canbus::LoopbackTransport::connect(
+                    *host, static_cast<openarm::canbus::LoopbackTransport&>(*bus.motor_side));
+                openarm = std::make_unique<openarm::can::socket::OpenArm>(std::move(host));
+            } else {
+                openarm = std::make_unique<openarm::can::socket::OpenArm>(
+                    bus.interface, options.use_fd, socket_options);
+            }
+
+            std::vector<MotorType> motor_types(options.motors, MotorType::DM4310);
+            std::vector<uint32_t> send_ids;
+            std::vector<uint32_t> recv_ids;
+            for (int m = 0; m < options.motors; ++m) {
+                uint32_t send_id = bus.next_send_id++;
+                send_ids.push_back(send_id);
+                recv_ids.push_back(send_id + kRecvIdOffset);
+                bus.simulator->add_motor(MotorType::DM4310, send_id, send_id + kRecvIdOffset);
+            }
+            openarm->init_arm_motors(motor_types, send_ids, recv_ids);
+            openarm->set_callback_mode_all(openarm::damiao_motor::CallbackMode::STATE);
+            results[arm_idx].interface = bus.interface;
+            arms.push_back(std::move(openarm));
+        }
+
+        for (auto& bus : buses) bus.simulator->start();
+        std::unique_ptr<openarm::canbus::CANInterfaceMonitor> interface_monitor;
+        std::unique_ptr<openarm::canbus::MetricsTextfileWriter> metrics_writer;
+        if (!options.metrics_textfile.empty()) {
+            if (!options.loopback) {
+                interface_monitor =
+                    std::make_unique<openarm::canbus::CANInterfaceMonitor>(options.interfaces);
+            }
+            metrics_writer = std::make_unique<openarm::canbus::MetricsTextfileWriter>(
+                openarm::canbus::MetricsRegistry::global(), options.metrics_textfile);
+        }
+        std::unique_ptr<openarm::canbus::TraceRecorder> trace_recorder;
+        if (!options.trace_path.empty()) {
+            trace_recorder = std::make_unique<openarm::canbus::TraceRecorder>(options.trace_path);
+            openarm::canbus::TraceRecorder::set_active(trace_recorder.get());
+        }
+
+        std::cout << "Running " << options.arms << " arm(s) x " << options.motors
+                  << " motor(s) at " << options.rate_hz << " Hz for " << options.duration_s
+                  << " s..." << std::endl;
+        const double cpu_start = process_cpu_seconds();
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (int arm_idx = 0; arm_idx < options.arms; ++arm_idx) {
+            threads.emplace_back(run_arm, std::ref(*arms[arm_idx]), std::cref(options),
+                                 std::ref(results[arm_idx]));
+        }
+        for (auto& thread : threads) thread.join();
+        const double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+        const double process_cpu_s = process_cpu_seconds() - cpu_start;
+
+        // The simulator socket sees every command and reply on its bus
+        std::vector<std::pair<std::string, double>> bus_loads;
+        for (auto& bus : buses) {
+            if (auto* socket = dynamic_cast<openarm::canbus::CANSocket*>(bus.motor_side.get())) {
+                bus_loads.emplace_back(bus.interface, socket->get_bus_load());
+            }
+        }
+
+        for (auto& bus : buses) bus.simulator->stop();
+        metrics_writer.reset();
+        print_report(options, results, wall_s, process_cpu_s);
+        if (!bus_loads.empty()) {
+            std::cout << "Bus load (last second, worst-case stuffing at "
+                      << options.bus_timing.bitrate / 1000 << "/"
+                      << options.bus_timing.data_bitrate / 1000 << " kbit/s):";
+            for (const auto& [interface, load] : bus_loads) {
+                std::cout << " " << interface << " " << std::setprecision(1) << 100.0 * load
+                          << "%";
+            }
+            std::cout << std::endl;
+        }
+        if (trace_recorder) {
+            openarm::canbus::TraceRecorder::set_active(nullptr);
+            std::cout << "Trace: " << trace_recorder->get_recorded() << " events written to "
+                      << options.trace_path << " (" << trace_recorder->get_dropped()
+                      << " dropped)" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -25,7 +25,12 @@
 
 namespace {
 volatile std::sig_atomic_t keep_running = 1;
-void signal_handler(int signum) { keep_running = 0; }
+// Disable every motor from the handler itself so Ctrl+C stops the arm even
+// when the control loop is stalled.
+void signal_handler(int /*signum*/) {
+    openarm::can::socket::OpenArm::estop_all();
+    keep_running = 0;
+}
 
 void print_usage(const char* program_name) {
     std::cout << "Usage (Single Motor) : " << program_name
@@ -35,8 +40,10 @@ void print_usage(const char* program_name) {
     std::cout << "Example: " << program_name << " --all 500 can0 -fd" << std::endl;
 }
 
-void display_stats(const std::vector<openarm::damiao_motor::Motor>& motors, double rtt_us,
-                   double target_hz, double actual_hz, uint64_t count) {
+void display_stats(const openarm::can::socket::ArmComponent& arm,
+                   const openarm::canbus::CycleStats& cycle_stats, double rtt_us, double target_hz,
+                   double actual_hz, uint64_t count) {
+    const auto motors = arm.get_motors();
     std::cout << "\033[2J\033[H";
     std::cout << "====================================================================="
               << std::endl;
@@ -55,20 +62,41 @@ void display_stats(const std::vector<openarm::damiao_motor::Motor>& motors, doub
     std::cout << "---------------------------------------------------------------------"
               << std::endl;
 
+    // Where the cycle time goes; a long wait_first_reply tail points at
+    // first_timeout_us, a long drain at too many round trips per cycle.
+    std::cout << " [Cycle Phases]  " << cycle_stats.get_cycles() << " cycles" << std::endl;
+    std::cout << " Phase            | p50 (us) | p99 (us) | max (us)" << std::endl;
+    for (size_t i = 0; i < openarm::canbus::kCyclePhaseCount; ++i) {
+        auto phase = static_cast<openarm::canbus::CyclePhase>(i);
+        const auto& histogram = cycle_stats.get_histogram(phase);
+        std::cout << " " << std::left << std::setw(16) << openarm::canbus::to_string(phase)
+                  << std::right << " | " << std::setw(8) << std::setprecision(2)
+                  << histogram.percentile(50) / 1000.0 << " | " << std::setw(8)
+                  << histogram.percentile(99) / 1000.0 << " | " << std::setw(8)
+                  << histogram.max() / 1000.0 << std::endl;
+    }
+    std::cout << "---------------------------------------------------------------------"
+              << std::endl;
+
     std::cout << " [Motor Status]" << std::endl;
-    std::cout << " ID(S/R) | Position (rad) | Velocity (rad/s) | Torque (Nm) | Temp(C)"
+    std::cout << " ID(S/R) | Position (rad) | Velocity (rad/s) | Torque (Nm) | Temp(C) | "
+                 "RTT p50/p99/max (us)"
               << std::endl;
-    std::cout << "---------+----------------+------------------+-------------+---------"
+    std::cout << "---------+----------------+------------------+-------------+---------+-"
+                 "--------------------"
               << std::endl;
 
-    for (const auto& motor : motors) {
+    for (size_t i = 0; i < motors.size(); ++i) {
+        const auto& motor = motors[i];
+        const auto& rtt = arm.get_rtt_histogram(i);
         std::cout << " " << std::setw(2) << motor.get_send_can_id() << "/" << std::setw(2)
                   << motor.get_recv_can_id() << "  | " << std::setw(14) << std::fixed
                   << std::setprecision(4) << motor.get_position() << " | " << std::setw(16)
                   << std::fixed << std::setprecision(4) << motor.get_velocity() << " | "
                   << std::setw(11) << std::fixed << std::setprecision(4) << motor.get_torque()
                   << " | " << std::setw(6) << std::fixed << std::setprecision(1)
-                  << motor.get_state_tmos() << std::endl;
+                  << motor.get_state_tmos() << "  | " << rtt.percentile(50) / 1000.0 << "/"
+                  << rtt.percentile(99) / 1000.0 << "/" << rtt.max() / 1000.0 << std::endl;
     }
 
     std::cout << "====================================================================="
@@ -172,10 +200,12 @@ int main(int argc, char* argv[]) {
             if (elapsed_stats >= 1.0) {
                 actual_hz = (loop_count - last_loop_count) / elapsed_stats;
 
-                const auto& motors = openarm.get_arm().get_motors();
-                if (!motors.empty()) {
-                    display_stats(motors, latest_rtt_us, target_hz, actual_hz, loop_count);
+                if (!openarm.get_arm().get_motors().empty()) {
+                    display_stats(openarm.get_arm(), openarm.get_cycle_stats(), latest_rtt_us,
+                                  target_hz, actual_hz, loop_count);
                 }
+                // Phase statistics cover the last refresh interval
+                openarm.reset_cycle_stats();
                 last_stats_time = now;
                 last_loop_count = loop_count;
             }
@@ -194,7 +224,11 @@ int main(int argc, char* argv[]) {
         }
 
         std::cout << "\nTerminating safely..." << std::endl;
-        openarm.disable_all();
+        openarm::can::socket::EStopResult estop_result = openarm.estop();
+        std::cout << "Emergency stop: " << estop_result.frames_queued << " frame(s) queued, "
+                  << estop_result.frames_failed << " failed, worst latency " << std::fixed
+                  << std::setprecision(2) << openarm.get_estop_max_latency_ns() / 1000.0 << " us"
+                  << std::endl;
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
         openarm.recv_all();
 
@@ -0,0 +1,91 @@
+// Copyright 2026 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <csignal>
+#include <iostream>
+#include <openarm/canbus/can_socket.hpp>
+#include <openarm/damiao_motor/dm_motor_simulator.hpp>
+#include <string>
+
+namespace {
+volatile std::sig_atomic_t keep_running = 1;
+void signal_handler(int /*signum*/) { keep_running = 0; }
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name
+              << " [interface] [-fd] [--motors <count>] [--latency-us <us>] [--rate-hz <hz>]"
+              << std::endl;
+    std::cout << "Emulates <count> DM4310 motors with send IDs 1..<count> and recv IDs "
+                 "0x11..0x10+<count>."
+              << std::endl;
+    std::cout << "Example: " << program_name << " vcan0 -fd --motors 8 --latency-us 150"
+              << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    std::string interface = "vcan0";
+    bool use_fd = false;
+    uint32_t motor_count = 8;
+    int latency_us = 0;
+    double rate_hz = 1000.0;
+
+    for (int arg_idx = 1; arg_idx < argc; ++arg_idx) {
+        std::string arg = argv[arg_idx];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "-fd") {
+            use_fd = true;
+        } else if (arg == "--motors" && arg_idx + 1 < argc) {
+            motor_count = std::stoul(argv[++arg_idx]);
+        } else if (arg == "--latency-us" && arg_idx + 1 < argc) {
+            latency_us = std::stoi(argv[++arg_idx]);
+        } else if (arg == "--rate-hz" && arg_idx + 1 < argc) {
+            rate_hz = std::stod(argv[++arg_idx]);
+        } else if (!arg.empty() && arg[0] != '-') {
+            interface = arg;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        openarm::canbus::CANSocket socket(interface, use_fd);
+        openarm::damiao_motor::DMMotorSimulator simulator(socket);
+        for (uint32_t id = 1; id <= motor_count; ++id) {
+            simulator.add_motor(openarm::damiao_motor::MotorType::DM4310, id, id + 0x10);
+        }
+        simulator.set_reply_latency_us(latency_us);
+        simulator.set_physics_rate_hz(rate_hz);
+
+        std::cout << "Simulating " << motor_count << " motor(s) on " << interface
+                  << (use_fd ? " (CAN-FD)" : "") << ", reply latency " << latency_us
+                  << " us, physics at " << rate_hz << " Hz" << std::endl;
+        std::cout << "Press Ctrl+C to stop." << std::endl;
+
+        while (keep_running) simulator.poll(1000);
+
+        std::cout << "\nReceived " << simulator.get_frames_received() << " frame(s), replied "
+                  << simulator.get_frames_replied() << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -23,12 +23,12 @@ _openarm_can_cli() {
     local cur prev words
     _init_completion || return
 
-    local subcommands="can_configure discover show_param write_param set_zero change_id change_baud enable disable clear_error monitor"
+    local subcommands="can_configure discover show_param write_param set_zero change_id change_baud enable disable clear_error monitor latency"
 
     local subcommand=""
     for word in "${words[@]}"; do
         case "${word}" in
-        can_configure | discover | show_param | write_param | set_zero | change_id | change_baud | enable | disable | clear_error | monitor)
+        can_configure | discover | show_param | write_param | set_zero | change_id | change_baud | enable | disable | clear_error | monitor | latency)
             subcommand="${word}"
             break
             ;;
@@ -52,7 +52,7 @@ _openarm_can_cli() {
             COMPREPLY=($(compgen -W "-b --bitrate -d --dbitrate --sp --dsp --dsjw --rm --no-fd" -- "${cur}"))
             ;;
         discover)
-            COMPREPLY=($(compgen -W "-m --max-id --full-scan" -- "${cur}"))
+            COMPREPLY=($(compgen -W "-m --max-id --full-scan --interfaces" -- "${cur}"))
             ;;
         enable | disable | clear_error | monitor | show_param | set_zero)
             COMPREPLY=($(compgen -W "-a --arm --no-arm --id" -- "${cur}"))
@@ -66,6 +66,9 @@ _openarm_can_cli() {
         write_param)
             COMPREPLY=($(compgen -W "-c --id -r --rid -v --value --save" -- "${cur}"))
             ;;
+        latency)
+            COMPREPLY=($(compgen -W "-a --arm --no-arm --id -n --count --interval-us" -- "${cur}"))
+            ;;
         esac
         return
     fi
@@ -20,8 +20,8 @@
 
 namespace openarm::can::socket {
 
-ArmComponent::ArmComponent(canbus::CANSocket& can_socket)
-    : damiao_motor::DMDeviceCollection(can_socket) {}
+ArmComponent::ArmComponent(canbus::CANTransport& transport)
+    : damiao_motor::DMDeviceCollection(transport) {}
 
 void ArmComponent::init_motor_devices(const std::vector<damiao_motor::MotorType>& motor_types,
                                       const std::vector<canid_t>& send_can_ids,
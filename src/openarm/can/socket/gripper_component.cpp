@@ -20,8 +20,8 @@
 
 namespace openarm::can::socket {
 
-GripperComponent::GripperComponent(canbus::CANSocket& can_socket)
-    : DMDeviceCollection(can_socket) {}
+GripperComponent::GripperComponent(canbus::CANTransport& transport)
+    : DMDeviceCollection(transport) {}
 
 void GripperComponent::init_motor_device(damiao_motor::MotorType motor_type, uint32_t send_can_id,
                                          uint32_t recv_can_id, bool use_fd,
@@ -14,19 +14,152 @@
 
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <time.h>
 
+#include <array>
+#include <memory>
 #include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/can_netlink.hpp>
+#include <openarm/canbus/log.hpp>
+#include <openarm/canbus/trace.hpp>
+#include <thread>
+#include <utility>
 
 #include "openarm/damiao_motor/dm_motor_constants.hpp"
 
 namespace openarm::can::socket {
 
-OpenArm::OpenArm(const std::string& can_interface, bool enable_fd)
-    : can_interface_(can_interface), enable_fd_(enable_fd) {
-    can_socket_ = std::make_unique<canbus::CANSocket>(can_interface_, enable_fd_);
-    master_can_device_collection_ = std::make_unique<canbus::CANDeviceCollection>(*can_socket_);
-    arm_ = std::make_unique<ArmComponent>(*can_socket_);
-    gripper_ = std::make_unique<GripperComponent>(*can_socket_);
+namespace {
+// Live instances for estop_all(). A fixed array of atomics keeps the
+// traversal lock free and async-signal-safe. estop_all() counts itself in
+// users of a slot holding an instance and then re-checks the slot, and
+// ~OpenArm clears instance before waiting for users to drop to zero, so an
+// instance seen on the re-check stays valid until the count is released.
+// Only calls using the instance hold the count, so other instances never
+// delay its destruction.
+struct EStopSlot {
+    std::atomic<OpenArm*> instance{nullptr};
+    std::atomic<int> users{0};
+};
+std::array<EStopSlot, OpenArm::kMaxEStopInstances> estop_slots;
+
+int64_t monotonic_now_ns() noexcept {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+int read_frames(canbus::CANTransport& transport, can_frame* frames, size_t count) {
+    return transport.read_can_frames(frames, count);
+}
+int read_frames(canbus::CANTransport& transport, canfd_frame* frames, size_t count) {
+    return transport.read_canfd_frames(frames, count);
+}
+
+// Read and dispatch until the bus goes quiet, tracing and timing each phase
+template <typename Frame>
+void drain_frames(canbus::CANTransport& transport, canbus::CANDeviceCollection& collection,
+                  canbus::CycleStats& cycle_stats, int timeout_us) {
+    // Frames are drained in batches to amortize the receive syscalls
+    constexpr size_t kRecvBatch = 32;
+    Frame response_frames[kRecvBatch];
+    auto wait_phase = canbus::CyclePhase::WAIT_FIRST_REPLY;
+    while (true) {
+        {
+            canbus::TraceScope trace("recv", "wait");
+            canbus::CyclePhaseTimer timer(&cycle_stats, wait_phase);
+            if (!transport.is_data_available(timeout_us)) break;
+        }
+        wait_phase = canbus::CyclePhase::DRAIN;
+        int count;
+        {
+            canbus::TraceScope trace("recv", "read");
+            canbus::CyclePhaseTimer timer(&cycle_stats, canbus::CyclePhase::DRAIN);
+            count = read_frames(transport, response_frames, kRecvBatch);
+        }
+        if (count <= 0) break;
+        canbus::TraceScope trace("recv", "dispatch");
+        canbus::CyclePhaseTimer timer(&cycle_stats, canbus::CyclePhase::DECODE);
+        for (int i = 0; i < count; ++i) {
+            collection.dispatch_frame_callback(response_frames[i]);
+        }
+        timeout_us = 0;
+    }
+}
+}  // namespace
+
+OpenArm::OpenArm(const std::string& can_interface, bool enable_fd,
+                 const canbus::CANSocketOptions& socket_options)
+    : OpenArm(std::make_unique<canbus::CANSocket>(can_interface, enable_fd, socket_options)) {}
+
+OpenArm::OpenArm(std::unique_ptr<canbus::CANTransport> transport)
+    : can_interface_(transport->get_interface()),
+      enable_fd_(transport->is_canfd_enabled()),
+      transport_(std::move(transport)) {
+    master_can_device_collection_ = std::make_unique<canbus::CANDeviceCollection>(*transport_);
+    tx_scheduler_ = std::make_unique<canbus::CANTxScheduler>(*transport_);
+    arm_ = std::make_unique<ArmComponent>(*transport_);
+    arm_->set_tx_scheduler(tx_scheduler_.get());
+    gripper_ = std::make_unique<GripperComponent>(*transport_);
+    gripper_->set_tx_scheduler(tx_scheduler_.get());
+    arm_->set_cycle_stats(&cycle_stats_);
+    gripper_->set_cycle_stats(&cycle_stats_);
+    transport_->get_error_monitor().set_callback(
+        [this](const canbus::CANErrorEvent& event) { handle_bus_error(event); });
+
+    estop_frame_sets_.push_back(std::make_unique<canbus::TxStopFrames>());
+    tx_scheduler_->set_stop_frames(estop_frame_sets_.back().get());
+    bool registered = false;
+    for (auto& slot : estop_slots) {
+        OpenArm* expected = nullptr;
+        if (slot.instance.compare_exchange_strong(expected, this)) {
+            registered = true;
+            break;
+        }
+    }
+    if (!registered) {
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::ERROR,
+                                     "More than %zu OpenArm instances; estop_all() will not "
+                                     "reach the one on %s",
+                                     kMaxEStopInstances, can_interface_.c_str());
+    }
+}
+
+OpenArm::~OpenArm() {
+    for (auto& slot : estop_slots) {
+        OpenArm* expected = this;
+        if (slot.instance.compare_exchange_strong(expected, nullptr)) {
+            while (slot.users.load() > 0) std::this_thread::yield();
+            break;
+        }
+    }
+    transport_->get_error_monitor().set_callback(nullptr);
+}
+
+void OpenArm::handle_bus_error(const canbus::CANErrorEvent& event) {
+    if (event.has(canbus::CANErrorClass::BUS_OFF)) {
+        canbus::Logger::global().log(bus_off_log_throttle_, canbus::LogLevel::ERROR,
+                                     "CAN bus-off on %s", can_interface_.c_str());
+        int64_t now_ns = monotonic_now_ns();
+        if (bus_off_recovery_ == BusOffRecovery::RESTART &&
+            now_ns - last_restart_ns_ >= kBusOffRestartIntervalNs) {
+            last_restart_ns_ = now_ns;
+            restarter_->request_restart();
+        }
+    } else if (event.state == canbus::CANBusState::ERROR_PASSIVE) {
+        canbus::Logger::global().log(error_passive_log_throttle_, canbus::LogLevel::WARNING,
+                                     "CAN controller error-passive on %s",
+                                     can_interface_.c_str());
+    }
+    if (bus_error_callback_) bus_error_callback_(event);
+}
+
+void OpenArm::set_bus_off_recovery(BusOffRecovery recovery) {
+    bus_off_recovery_ = recovery;
+    if (recovery == BusOffRecovery::RESTART && !restarter_) {
+        restarter_ = std::make_unique<canbus::CANInterfaceRestarter>(can_interface_);
+    }
 }
 
 void OpenArm::init_arm_motors(const std::vector<damiao_motor::MotorType>& motor_types,
@@ -55,6 +188,71 @@ void OpenArm::register_dm_device_collection(damiao_motor::DMDeviceCollection& de
         master_can_device_collection_->add_device(device);
     }
     sub_dm_device_collections_.push_back(&device_collection);
+
+    auto frames = std::make_unique<canbus::TxStopFrames>();
+    for (damiao_motor::DMDeviceCollection* sub_collection : sub_dm_device_collections_) {
+        for (const auto& [id, device] : sub_collection->get_device_collection().get_devices()) {
+            auto dm_device = std::dynamic_pointer_cast<damiao_motor::DMCANDevice>(device);
+            if (!dm_device) continue;
+            frames->can_frames.push_back(
+                dm_device->get_constant_can_frame(damiao_motor::ConstantCommand::DISABLE));
+            frames->canfd_frames.push_back(
+                dm_device->get_constant_canfd_frame(damiao_motor::ConstantCommand::DISABLE));
+        }
+    }
+    tx_scheduler_->set_stop_frames(frames.get());
+    estop_frame_sets_.push_back(std::move(frames));
+}
+
+EStopResult OpenArm::estop() noexcept {
+    int64_t start_ns = monotonic_now_ns();
+    EStopResult result = write_estop_frames(false);
+    result.latency_ns = monotonic_now_ns() - start_ns;
+    record_estop_latency(result.latency_ns);
+    return result;
+}
+
+EStopResult OpenArm::estop_all() noexcept {
+    int64_t start_ns = monotonic_now_ns();
+    EStopResult total;
+    for (auto& slot : estop_slots) {
+        OpenArm* openarm = slot.instance.load();
+        if (!openarm) continue;
+        slot.users.fetch_add(1);
+        if (slot.instance.load() == openarm) {
+            EStopResult result = openarm->write_estop_frames(true);
+            total.frames_queued += result.frames_queued;
+            total.frames_failed += result.frames_failed;
+            total.frames_deferred += result.frames_deferred;
+            // Time until this instance's frames were queued
+            openarm->record_estop_latency(monotonic_now_ns() - start_ns);
+        }
+        slot.users.fetch_sub(1);
+    }
+    total.latency_ns = monotonic_now_ns() - start_ns;
+    return total;
+}
+
+EStopResult OpenArm::write_estop_frames(bool defer_unsafe) noexcept {
+    // The scheduler also discards queued enables and setpoints, so none of
+    // them reaches the wire after the disables
+    EStopResult result;
+    if (defer_unsafe && !transport_->is_async_signal_safe()) {
+        result.frames_deferred = tx_scheduler_->defer_stop().pending;
+        return result;
+    }
+    canbus::TxStopResult stop_result = tx_scheduler_->stop();
+    result.frames_queued = stop_result.written;
+    result.frames_failed = stop_result.pending;
+    return result;
+}
+
+void OpenArm::record_estop_latency(int64_t latency_ns) noexcept {
+    int64_t current = estop_max_latency_ns_.load(std::memory_order_relaxed);
+    while (latency_ns > current &&
+           !estop_max_latency_ns_.compare_exchange_weak(current, latency_ns,
+                                                        std::memory_order_relaxed)) {
+    }
 }
 
 void OpenArm::enable_all() {
@@ -87,6 +285,12 @@ void OpenArm::disable_all() {
     }
 }
 
+void OpenArm::clear_error_all() {
+    for (damiao_motor::DMDeviceCollection* device_collection : sub_dm_device_collections_) {
+        device_collection->clear_error_all();
+    }
+}
+
 void OpenArm::recv_all(int first_timeout_us) {
     // The timeout for select() of the first response is set to
     // first_timeout_us (default: 500 us). Following responses use 0
@@ -94,39 +298,48 @@ void OpenArm::recv_all(int first_timeout_us) {
     //
     // Tuning this value may improve the performance but should be
     // done with caution.
-    int timeout_us = first_timeout_us;
+    canbus::TraceScope trace("recv", "recv_all");
 
-    // CAN FD
-    if (enable_fd_) {
-        canfd_frame response_frame;
-        while (can_socket_->is_data_available(timeout_us) &&
-               can_socket_->read_canfd_frame(response_frame)) {
-            master_can_device_collection_->dispatch_frame_callback(response_frame);
-            timeout_us = 0;
-        }
+    // Frames refused earlier by the socket go out before we wait for replies
+    {
+        canbus::TraceScope flush_trace("recv", "flush_tx");
+        canbus::CyclePhaseTimer timer(&cycle_stats_, canbus::CyclePhase::TX);
+        tx_scheduler_->flush();
     }
-    // CAN 2.0
-    else {
-        can_frame response_frame;
-        while (can_socket_->is_data_available(timeout_us) &&
-               can_socket_->read_can_frame(response_frame)) {
-            master_can_device_collection_->dispatch_frame_callback(response_frame);
-            timeout_us = 0;
-        }
+
+    if (enable_fd_) {
+        drain_frames<canfd_frame>(*transport_, *master_can_device_collection_, cycle_stats_,
+                                  first_timeout_us);
+    } else {
+        drain_frames<can_frame>(*transport_, *master_can_device_collection_, cycle_stats_,
+                                first_timeout_us);
     }
-    // }
+    cycle_stats_.end_cycle();
 }
 
+size_t OpenArm::flush_tx() { return tx_scheduler_->flush(); }
+
 void OpenArm::query_param_all(int RID) {
     for (damiao_motor::DMDeviceCollection* device_collection : sub_dm_device_collections_) {
         device_collection->query_param_all(RID);
     }
 }
 
+void OpenArm::set_frame_recorder(canbus::FrameRecorder* frame_recorder) {
+    transport_->set_frame_recorder(frame_recorder);
+    master_can_device_collection_->set_frame_recorder(frame_recorder);
+}
+
 void OpenArm::set_callback_mode_all(damiao_motor::CallbackMode callback_mode) {
     for (damiao_motor::DMDeviceCollection* device_collection : sub_dm_device_collections_) {
         device_collection->set_callback_mode_all(callback_mode);
     }
 }
 
+void OpenArm::set_fault_callback_all(const damiao_motor::FaultCallback& fault_callback) {
+    for (damiao_motor::DMDeviceCollection* device_collection : sub_dm_device_collections_) {
+        device_collection->set_fault_callback_all(fault_callback);
+    }
+}
+
 }  // namespace openarm::can::socket
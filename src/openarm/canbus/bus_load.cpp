@@ -0,0 +1,109 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+
+#include <algorithm>
+#include <openarm/canbus/bus_load.hpp>
+
+namespace openarm::canbus {
+
+namespace {
+int64_t monotonic_now_ns() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// Dynamic stuffing inserts at most one bit after every four equal bits
+uint32_t worst_case_stuff_bits(uint32_t bits) { return bits == 0 ? 0 : (bits - 1) / 4; }
+
+// CRC delimiter, ACK slot and delimiter, end of frame, interframe space
+constexpr uint32_t kTrailerBits = 1 + 2 + 7 + 3;
+
+uint64_t bits_to_ns(uint64_t bits, uint32_t bitrate) {
+    return bitrate == 0 ? 0 : bits * 1000000000ULL / bitrate;
+}
+}  // namespace
+
+uint64_t frame_duration_ns(const can_frame& frame, const BusTiming& timing) {
+    // can_dlc rather than len, which older kernel headers do not declare
+    uint32_t data_bits =
+        (frame.can_id & CAN_RTR_FLAG) ? 0 : 8u * std::min<uint8_t>(frame.can_dlc, CAN_MAX_DLEN);
+    // SOF, identifier, control field and CRC are subject to stuffing
+    uint32_t header_bits = (frame.can_id & CAN_EFF_FLAG) ? 1 + 11 + 1 + 1 + 18 + 1 + 2 + 4
+                                                         : 1 + 11 + 1 + 1 + 1 + 4;
+    uint32_t stuffed = header_bits + data_bits + 15;
+    return bits_to_ns(stuffed + worst_case_stuff_bits(stuffed) + kTrailerBits, timing.bitrate);
+}
+
+uint64_t frame_duration_ns(const canfd_frame& frame, const BusTiming& timing) {
+    // Arbitration phase up to and including BRS, at the nominal rate
+    uint32_t arbitration_bits = (frame.can_id & CAN_EFF_FLAG)
+                                    ? 1 + 11 + 1 + 1 + 18 + 1 + 1 + 1 + 1
+                                    : 1 + 11 + 1 + 1 + 1 + 1 + 1;
+    uint32_t nominal_bits =
+        arbitration_bits + worst_case_stuff_bits(arbitration_bits) + kTrailerBits;
+
+    // ESI, DLC and data are dynamically stuffed; the stuff count and CRC use
+    // a fixed stuff bit every four bits.
+    uint32_t len = std::min<uint8_t>(frame.len, CANFD_MAX_DLEN);
+    uint32_t dynamic_bits = 1 + 4 + 8 * len;
+    uint32_t crc_bits = len > 16 ? 21 : 17;
+    uint32_t fixed_bits = 4 + crc_bits;
+    uint32_t data_phase_bits =
+        dynamic_bits + worst_case_stuff_bits(dynamic_bits) + fixed_bits + (fixed_bits + 3) / 4;
+
+    uint32_t data_bitrate = (frame.flags & CANFD_BRS) ? timing.data_bitrate : timing.bitrate;
+    return bits_to_ns(nominal_bits, timing.bitrate) + bits_to_ns(data_phase_bits, data_bitrate);
+}
+
+BusLoadEstimator::BusLoadEstimator(const BusTiming& timing, Gauge* gauge, int64_t interval_ns)
+    : timing_(timing),
+      gauge_(gauge),
+      interval_ns_(interval_ns),
+      interval_start_ns_(monotonic_now_ns()) {}
+
+void BusLoadEstimator::record(const can_frame* frames, size_t count) noexcept {
+    uint64_t busy_ns = 0;
+    for (size_t i = 0; i < count; ++i) busy_ns += frame_duration_ns(frames[i], timing_);
+    add(busy_ns);
+}
+
+void BusLoadEstimator::record(const canfd_frame* frames, size_t count) noexcept {
+    uint64_t busy_ns = 0;
+    for (size_t i = 0; i < count; ++i) busy_ns += frame_duration_ns(frames[i], timing_);
+    add(busy_ns);
+}
+
+void BusLoadEstimator::add(uint64_t busy_ns) noexcept {
+    busy_ns_.fetch_add(busy_ns, std::memory_order_relaxed);
+    update();
+}
+
+void BusLoadEstimator::update() noexcept {
+    int64_t now = monotonic_now_ns();
+    int64_t start = interval_start_ns_.load(std::memory_order_relaxed);
+    if (now - start < interval_ns_) return;
+    // One caller closes the interval; the others keep adding to the next
+    if (!interval_start_ns_.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        return;
+    }
+    uint64_t busy_ns = busy_ns_.exchange(0, std::memory_order_relaxed);
+    double load = static_cast<double>(busy_ns) / static_cast<double>(now - start);
+    load_.store(load, std::memory_order_relaxed);
+    if (gauge_) gauge_->set(load);
+}
+
+}  // namespace openarm::canbus
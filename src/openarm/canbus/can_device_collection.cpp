@@ -12,13 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <iostream>
+#include <cstdio>
 #include <openarm/canbus/can_device_collection.hpp>
-#include <openarm/canbus/can_socket.hpp>
 
 namespace openarm::canbus {
 
-CANDeviceCollection::CANDeviceCollection(CANSocket& can_socket) : can_socket_(can_socket) {}
+namespace {
+std::string format_can_id(canid_t can_id) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "0x%02X", can_id);
+    return buffer;
+}
+}  // namespace
+
+CANDeviceCollection::CANDeviceCollection(CANTransport& transport)
+    : transport_(transport),
+      unknown_id_frames_(MetricsRegistry::global().counter(
+          "openarm_can_unknown_id_frames_total", "Received frames with no registered device",
+          {{"interface", transport.get_interface()}})) {}
 
 CANDeviceCollection::~CANDeviceCollection() {}
 
@@ -28,6 +39,10 @@ void CANDeviceCollection::add_device(const std::shared_ptr<CANDevice>& device) {
     // Add device to our collection
     canid_t device_id = device->get_recv_can_id();
     devices_[device_id] = device;
+    device->bind_metrics(MetricsRegistry::global(),
+                         {{"interface", transport_.get_interface()},
+                          {"send_id", format_can_id(device->get_send_can_id())},
+                          {"recv_id", format_can_id(device_id)}});
 }
 
 void CANDeviceCollection::remove_device(const std::shared_ptr<CANDevice>& device) {
@@ -42,21 +57,29 @@ void CANDeviceCollection::remove_device(const std::shared_ptr<CANDevice>& device
 }
 
 void CANDeviceCollection::dispatch_frame_callback(can_frame& frame) {
+    if (frame_recorder_) frame_recorder_->record(FrameDirection::RX, frame);
     auto it = devices_.find(frame.can_id);
     if (it != devices_.end()) {
+        it->second->record_rx();
         it->second->callback(frame);
+    } else {
+        // Frames for unknown devices are normal on a shared bus, so they are
+        // only counted
+        unknown_id_frames_.inc();
     }
-    // Note: Silently ignore frames for unknown devices (this is normal in CAN
-    // networks)
 }
 
 void CANDeviceCollection::dispatch_frame_callback(canfd_frame& frame) {
+    if (frame_recorder_) frame_recorder_->record(FrameDirection::RX, frame);
     auto it = devices_.find(frame.can_id);
     if (it != devices_.end()) {
+        it->second->record_rx();
         it->second->callback(frame);
+    } else {
+        // Frames for unknown devices are normal on a shared bus, so they are
+        // only counted
+        unknown_id_frames_.inc();
     }
-    // Note: Silently ignore frames for unknown devices (this is normal in CAN
-    // networks)
 }
 
 }  // namespace openarm::canbus
@@ -0,0 +1,127 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <linux/can/error.h>
+
+#include <openarm/canbus/can_error.hpp>
+
+namespace openarm::canbus {
+
+namespace {
+// Worse of the RX and TX states in a CAN_ERR_CRTL status byte
+CANBusState controller_state(uint8_t status, CANBusState previous_state) {
+    if (status & (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE)) {
+        return CANBusState::ERROR_PASSIVE;
+    }
+    if (status & (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING)) {
+        return CANBusState::ERROR_WARNING;
+    }
+    if (status & CAN_ERR_CRTL_ACTIVE) return CANBusState::ERROR_ACTIVE;
+    return previous_state;
+}
+}  // namespace
+
+const char* to_string(CANBusState state) {
+    switch (state) {
+        case CANBusState::ERROR_ACTIVE:
+            return "ERROR-ACTIVE";
+        case CANBusState::ERROR_WARNING:
+            return "ERROR-WARNING";
+        case CANBusState::ERROR_PASSIVE:
+            return "ERROR-PASSIVE";
+        case CANBusState::BUS_OFF:
+            return "BUS-OFF";
+        case CANBusState::STOPPED:
+            return "STOPPED";
+    }
+    return "UNKNOWN";
+}
+
+const char* to_string(CANErrorClass error_class) {
+    switch (error_class) {
+        case CANErrorClass::TX_TIMEOUT:
+            return "tx_timeout";
+        case CANErrorClass::LOST_ARBITRATION:
+            return "lost_arbitration";
+        case CANErrorClass::CONTROLLER:
+            return "controller";
+        case CANErrorClass::PROTOCOL:
+            return "protocol";
+        case CANErrorClass::TRANSCEIVER:
+            return "transceiver";
+        case CANErrorClass::NO_ACK:
+            return "no_ack";
+        case CANErrorClass::BUS_OFF:
+            return "bus_off";
+        case CANErrorClass::BUS_ERROR:
+            return "bus_error";
+        case CANErrorClass::RESTARTED:
+            return "restarted";
+        case CANErrorClass::COUNT:
+            break;
+    }
+    return "unknown";
+}
+
+CANErrorEvent decode_error_frame(const can_frame& frame, CANBusState previous_state) {
+    CANErrorEvent event;
+    event.classes = frame.can_id & CAN_ERR_MASK;
+    event.state = previous_state;
+    if (event.has(CANErrorClass::CONTROLLER)) {
+        event.rx_overflow = frame.data[1] & CAN_ERR_CRTL_RX_OVERFLOW;
+        event.tx_overflow = frame.data[1] & CAN_ERR_CRTL_TX_OVERFLOW;
+        event.state = controller_state(frame.data[1], previous_state);
+    }
+    if (event.has(CANErrorClass::RESTARTED)) event.state = CANBusState::ERROR_ACTIVE;
+    if (event.has(CANErrorClass::BUS_OFF)) event.state = CANBusState::BUS_OFF;
+    if (frame.can_id & CAN_ERR_CNT) {
+        event.has_error_counters = true;
+        event.tx_error_counter = frame.data[6];
+        event.rx_error_counter = frame.data[7];
+    }
+    return event;
+}
+
+bool CANErrorMonitor::process(const can_frame& frame) {
+    if (!(frame.can_id & CAN_ERR_FLAG)) return false;
+
+    CANErrorEvent event = decode_error_frame(frame, state_);
+    state_ = event.state;
+    if (state_metric_) state_metric_->set(static_cast<double>(event.state));
+    ++error_frames_;
+    for (size_t i = 0; i < kClassCount; ++i) {
+        if (!event.has(static_cast<CANErrorClass>(i))) continue;
+        ++class_counts_[i];
+        if (class_metrics_[i]) class_metrics_[i]->inc();
+    }
+    if (callback_) callback_(event);
+    return true;
+}
+
+void CANErrorMonitor::bind_metrics(MetricsRegistry& registry, const MetricLabels& labels) {
+    if (state_metric_) return;
+    for (size_t i = 0; i < kClassCount; ++i) {
+        MetricLabels class_labels = labels;
+        class_labels.emplace_back("class", to_string(static_cast<CANErrorClass>(i)));
+        class_metrics_[i] = &registry.counter("openarm_can_bus_error_frames_total",
+                                              "Error frames by class", class_labels);
+        class_metrics_[i]->inc(class_counts_[i]);
+    }
+    state_metric_ = &registry.gauge(
+        "openarm_can_bus_state",
+        "Controller state: 0 error-active, 1 error-warning, 2 error-passive, 3 bus-off", labels);
+    state_metric_->set(static_cast<double>(state_));
+}
+
+}  // namespace openarm::canbus
@@ -0,0 +1,138 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <openarm/canbus/can_interface_monitor.hpp>
+
+namespace openarm::canbus {
+
+namespace {
+struct CounterField {
+    const char* name;
+    const char* help;
+    uint64_t (*read)(const CANInterfaceStatus& status);
+};
+
+// Cumulative kernel counters, mirrored as deltas
+constexpr CounterField kCounterFields[] = {
+    {"openarm_can_interface_bus_errors_total", "Bus errors seen by the controller",
+     [](const CANInterfaceStatus& s) -> uint64_t { return s.bus_errors; }},
+    {"openarm_can_interface_error_warning_total", "Transitions to error-warning",
+     [](const CANInterfaceStatus& s) -> uint64_t { return s.error_warning; }},
+    {"openarm_can_interface_error_passive_total", "Transitions to error-passive",
+     [](const CANInterfaceStatus& s) -> uint64_t { return s.error_passive; }},
+    {"openarm_can_interface_bus_off_total", "Transitions to bus-off",
+     [](const CANInterfaceStatus& s) -> uint64_t { return s.bus_off; }},
+    {"openarm_can_interface_arbitration_lost_total", "Arbitration losses",
+     [](const CANInterfaceStatus& s) -> uint64_t { return s.arbitration_lost; }},
+    {"openarm_can_interface_restarts_total", "Controller restarts after bus-off",
+     [](const CANInterfaceStatus& s) -> uint64_t { return s.restarts; }},
+    {"openarm_can_interface_rx_errors_total", "Receive errors",
+     [](const CANInterfaceStatus& s) { return s.rx_errors; }},
+    {"openarm_can_interface_tx_errors_total", "Transmit errors",
+     [](const CANInterfaceStatus& s) { return s.tx_errors; }},
+    {"openarm_can_interface_rx_dropped_total", "Frames dropped on receive",
+     [](const CANInterfaceStatus& s) { return s.rx_dropped; }},
+    {"openarm_can_interface_tx_dropped_total", "Frames dropped on transmit",
+     [](const CANInterfaceStatus& s) { return s.tx_dropped; }},
+    {"openarm_can_interface_rx_over_errors_total", "Controller receive overruns",
+     [](const CANInterfaceStatus& s) { return s.rx_over_errors; }},
+};
+static_assert(sizeof(kCounterFields) / sizeof(kCounterFields[0]) == 11);
+}  // namespace
+
+CANInterfaceMonitor::CANInterfaceMonitor(const std::vector<std::string>& interfaces,
+                                         MetricsRegistry& registry, int interval_ms)
+    : interval_ms_(interval_ms), interfaces_(interfaces.size()) {
+    for (size_t i = 0; i < interfaces.size(); ++i) {
+        Interface& interface = interfaces_[i];
+        MetricLabels labels = {{"interface", interfaces[i]}};
+        interface.name = interfaces[i];
+        interface.state = &registry.gauge(
+            "openarm_can_interface_state",
+            "Kernel CAN state: 0 error-active, 1 error-warning, 2 error-passive, 3 bus-off, "
+            "4 stopped",
+            labels);
+        interface.tx_error_counter = &registry.gauge("openarm_can_interface_tx_error_counter",
+                                                     "Controller transmit error counter", labels);
+        interface.rx_error_counter = &registry.gauge("openarm_can_interface_rx_error_counter",
+                                                     "Controller receive error counter", labels);
+        for (size_t c = 0; c < kCounterCount; ++c) {
+            interface.counters[c] =
+                &registry.counter(kCounterFields[c].name, kCounterFields[c].help, labels);
+        }
+    }
+    poll();
+    thread_ = std::thread(&CANInterfaceMonitor::run, this);
+}
+
+CANInterfaceMonitor::~CANInterfaceMonitor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.join();
+}
+
+void CANInterfaceMonitor::poll() {
+    std::lock_guard<std::mutex> poll_lock(poll_mutex_);
+    for (Interface& interface : interfaces_) {
+        CANInterfaceStatus status;
+        try {
+            status = read_can_interface_status(interface.name);
+        } catch (const CANNetlinkException&) {
+            ++poll_failures_;
+            continue;
+        }
+        publish(interface, status);
+    }
+}
+
+void CANInterfaceMonitor::publish(Interface& interface, const CANInterfaceStatus& status) {
+    interface.state->set(static_cast<double>(status.state));
+    interface.tx_error_counter->set(status.tx_error_counter);
+    interface.rx_error_counter->set(status.rx_error_counter);
+    for (size_t c = 0; c < kCounterCount; ++c) {
+        uint64_t value = kCounterFields[c].read(status);
+        uint64_t& last = interface.last_values[c];
+        // A smaller value means the interface was recreated; count it afresh
+        interface.counters[c]->inc(value >= last ? value - last : value);
+        last = value;
+    }
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    interface.status = status;
+    interface.valid = true;
+}
+
+bool CANInterfaceMonitor::get_status(size_t index, CANInterfaceStatus& status) const {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (index >= interfaces_.size() || !interfaces_[index].valid) return false;
+    status = interfaces_[index].status;
+    return true;
+}
+
+void CANInterfaceMonitor::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wakeup_.wait_for(lock, std::chrono::milliseconds(interval_ms_),
+                         [this] { return stopping_; });
+        if (stopping_) break;
+        lock.unlock();
+        poll();
+        lock.lock();
+    }
+}
+
+}  // namespace openarm::canbus
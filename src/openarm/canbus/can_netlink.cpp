@@ -0,0 +1,370 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <linux/can/netlink.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <functional>
+#include <openarm/canbus/can_netlink.hpp>
+#include <openarm/canbus/log.hpp>
+#include <vector>
+
+namespace openarm::canbus {
+
+namespace {
+// Link request for one interface, built in a fixed buffer
+class LinkRequest {
+public:
+    LinkRequest(const std::string& interface, uint16_t type) {
+        memset(buffer_, 0, sizeof(buffer_));
+        header()->nlmsg_len = NLMSG_LENGTH(sizeof(ifinfomsg));
+        header()->nlmsg_type = type;
+        header()->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+        info()->ifi_family = AF_UNSPEC;
+        info()->ifi_index = static_cast<int>(if_nametoindex(interface.c_str()));
+        if (info()->ifi_index == 0) {
+            throw CANNetlinkException("no interface " + interface, errno);
+        }
+    }
+
+    void add(uint16_t type, const void* data, size_t size) {
+        size_t offset = NLMSG_ALIGN(header()->nlmsg_len);
+        size_t length = RTA_LENGTH(size);
+        if (offset + RTA_ALIGN(length) > sizeof(buffer_)) {
+            throw CANNetlinkException("request too large", EMSGSIZE);
+        }
+        auto* attr = reinterpret_cast<rtattr*>(buffer_ + offset);
+        attr->rta_type = type;
+        attr->rta_len = static_cast<uint16_t>(length);
+        if (size > 0) memcpy(RTA_DATA(attr), data, size);
+        header()->nlmsg_len = static_cast<uint32_t>(offset + RTA_ALIGN(length));
+    }
+    void add_u32(uint16_t type, uint32_t value) { add(type, &value, sizeof(value)); }
+    template <typename T>
+    void add_struct(uint16_t type, const T& value) {
+        add(type, &value, sizeof(value));
+    }
+    void add_string(uint16_t type, const char* value) { add(type, value, strlen(value) + 1); }
+
+    // Nested attributes are added between begin_nested() and end_nested()
+    size_t begin_nested(uint16_t type) {
+        size_t offset = NLMSG_ALIGN(header()->nlmsg_len);
+        add(type, nullptr, 0);
+        return offset;
+    }
+    void end_nested(size_t offset) {
+        auto* attr = reinterpret_cast<rtattr*>(buffer_ + offset);
+        attr->rta_len = static_cast<uint16_t>(header()->nlmsg_len - offset);
+    }
+
+    nlmsghdr* header() { return reinterpret_cast<nlmsghdr*>(buffer_); }
+    ifinfomsg* info() { return static_cast<ifinfomsg*>(NLMSG_DATA(header())); }
+
+private:
+    alignas(nlmsghdr) char buffer_[512];
+};
+
+class NetlinkSocket {
+public:
+    NetlinkSocket() : fd_(socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE)) {
+        if (fd_ < 0) throw CANNetlinkException("socket", errno);
+        // Ask for the kernel's explanation of rejected requests; older
+        // kernels without extended acks still report the errno
+        int one = 1;
+        (void)setsockopt(fd_, SOL_NETLINK, NETLINK_EXT_ACK, &one, sizeof(one));
+    }
+    ~NetlinkSocket() { close(fd_); }
+
+    NetlinkSocket(const NetlinkSocket&) = delete;
+    NetlinkSocket& operator=(const NetlinkSocket&) = delete;
+
+    // Send the request and wait for the kernel's acknowledgement. Replies
+    // that come before it are passed to on_reply.
+    void transact(nlmsghdr* request, const std::string& what,
+                  const std::function<void(const nlmsghdr*)>& on_reply = nullptr) {
+        request->nlmsg_seq = ++sequence_;
+        if (send(fd_, request, request->nlmsg_len, 0) < 0) {
+            throw CANNetlinkException(what, errno);
+        }
+        // Link dumps with statistics run to a few kilobytes
+        std::vector<char> reply(32768);
+        while (true) {
+            ssize_t size = recv(fd_, reply.data(), reply.size(), 0);
+            if (size < 0) {
+                if (errno == EINTR) continue;
+                throw CANNetlinkException(what, errno);
+            }
+            int remaining = static_cast<int>(size);
+            for (auto* message = reinterpret_cast<nlmsghdr*>(reply.data());
+                 NLMSG_OK(message, remaining); message = NLMSG_NEXT(message, remaining)) {
+                if (message->nlmsg_seq != sequence_) continue;
+                if (message->nlmsg_type != NLMSG_ERROR) {
+                    if (on_reply) on_reply(message);
+                    continue;
+                }
+                auto* error = static_cast<nlmsgerr*>(NLMSG_DATA(message));
+                if (error->error != 0) {
+                    throw CANNetlinkException(what + extended_ack(message), -error->error);
+                }
+                return;
+            }
+        }
+    }
+
+private:
+    // ": <reason>" from the NLMSGERR_ATTR_MSG of an error reply, if any
+    static std::string extended_ack(const nlmsghdr* message) {
+        if (!(message->nlmsg_flags & NLM_F_ACK_TLVS)) return "";
+        auto* error = static_cast<const nlmsgerr*>(NLMSG_DATA(message));
+        // Unless capped, the rejected request is echoed before the attributes
+        size_t offset = sizeof(nlmsgerr);
+        if (!(message->nlmsg_flags & NLM_F_CAPPED)) offset += error->msg.nlmsg_len - NLMSG_HDRLEN;
+        int length = static_cast<int>(message->nlmsg_len) - static_cast<int>(NLMSG_HDRLEN + offset);
+        auto* attr = reinterpret_cast<const rtattr*>(
+            reinterpret_cast<const char*>(NLMSG_DATA(message)) + offset);
+        for (; length > 0 && RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+            if (attr->rta_type != NLMSGERR_ATTR_MSG) continue;
+            return ": " + std::string(static_cast<const char*>(RTA_DATA(attr)),
+                                      strnlen(static_cast<const char*>(RTA_DATA(attr)),
+                                              RTA_PAYLOAD(attr)));
+        }
+        return "";
+    }
+
+    int fd_;
+    uint32_t sequence_ = 0;
+};
+
+void set_up(NetlinkSocket& netlink, const std::string& interface, bool up) {
+    LinkRequest request(interface, RTM_NEWLINK);
+    request.info()->ifi_change = IFF_UP;
+    request.info()->ifi_flags = up ? IFF_UP : 0;
+    netlink.transact(request.header(), (up ? "bring up " : "bring down ") + interface);
+}
+
+// Bitrate and sample point only, so the kernel calculates the segments
+can_bittiming bit_timing(uint32_t bitrate, uint32_t sample_point, uint32_t sjw) {
+    can_bittiming timing;
+    memset(&timing, 0, sizeof(timing));
+    timing.bitrate = bitrate;
+    timing.sample_point = sample_point;
+    timing.sjw = sjw;
+    return timing;
+}
+
+// Index the attributes in [attr, attr + length) by type
+template <size_t N>
+void parse_attributes(const rtattr* attr, int length, const rtattr* (&table)[N]) {
+    for (auto& entry : table) entry = nullptr;
+    for (; RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+        if (attr->rta_type < N) table[attr->rta_type] = attr;
+    }
+}
+
+template <size_t N>
+void parse_nested(const rtattr* nested, const rtattr* (&table)[N]) {
+    parse_attributes(static_cast<const rtattr*>(RTA_DATA(nested)),
+                     static_cast<int>(RTA_PAYLOAD(nested)), table);
+}
+
+// Copy a fixed size payload, tolerating older kernels that send less
+template <typename T>
+void read_attribute(const rtattr* attr, T& value) {
+    memset(&value, 0, sizeof(value));
+    if (attr) memcpy(&value, RTA_DATA(attr), std::min<size_t>(RTA_PAYLOAD(attr), sizeof(value)));
+}
+
+void parse_can_info(const rtattr* info_data, CANInterfaceStatus& status) {
+    const rtattr* can[IFLA_CAN_MAX + 1];
+    parse_nested(info_data, can);
+    if (can[IFLA_CAN_STATE]) {
+        uint32_t state;
+        read_attribute(can[IFLA_CAN_STATE], state);
+        // Sleeping controllers are as unavailable as stopped ones
+        status.state = state <= CAN_STATE_BUS_OFF ? static_cast<CANBusState>(state)
+                                                  : CANBusState::STOPPED;
+    }
+    if (can[IFLA_CAN_BERR_COUNTER]) {
+        can_berr_counter counter;
+        read_attribute(can[IFLA_CAN_BERR_COUNTER], counter);
+        status.has_error_counters = true;
+        status.tx_error_counter = counter.txerr;
+        status.rx_error_counter = counter.rxerr;
+    }
+    if (can[IFLA_CAN_BITTIMING]) {
+        can_bittiming timing;
+        read_attribute(can[IFLA_CAN_BITTIMING], timing);
+        status.bitrate = timing.bitrate;
+        status.sample_point = timing.sample_point;
+    }
+    if (can[IFLA_CAN_DATA_BITTIMING]) {
+        can_bittiming timing;
+        read_attribute(can[IFLA_CAN_DATA_BITTIMING], timing);
+        status.data_bitrate = timing.bitrate;
+    }
+    read_attribute(can[IFLA_CAN_RESTART_MS], status.restart_ms);
+}
+
+void parse_link(const nlmsghdr* message, CANInterfaceStatus& status) {
+    if (message->nlmsg_type != RTM_NEWLINK) return;
+    auto* info = static_cast<const ifinfomsg*>(NLMSG_DATA(message));
+    status.up = info->ifi_flags & IFF_UP;
+    status.running = info->ifi_flags & IFF_RUNNING;
+
+    const rtattr* link[IFLA_MAX + 1];
+    parse_attributes(IFLA_RTA(info), static_cast<int>(IFLA_PAYLOAD(message)), link);
+    if (link[IFLA_STATS64]) {
+        rtnl_link_stats64 stats;
+        read_attribute(link[IFLA_STATS64], stats);
+        status.rx_packets = stats.rx_packets;
+        status.tx_packets = stats.tx_packets;
+        status.rx_errors = stats.rx_errors;
+        status.tx_errors = stats.tx_errors;
+        status.rx_dropped = stats.rx_dropped;
+        status.tx_dropped = stats.tx_dropped;
+        status.rx_over_errors = stats.rx_over_errors;
+    }
+    if (!link[IFLA_LINKINFO]) return;
+
+    const rtattr* link_info[IFLA_INFO_MAX + 1];
+    parse_nested(link[IFLA_LINKINFO], link_info);
+    const rtattr* kind = link_info[IFLA_INFO_KIND];
+    if (!kind || strncmp(static_cast<const char*>(RTA_DATA(kind)), "can", RTA_PAYLOAD(kind))) {
+        return;
+    }
+    status.is_can = true;
+    if (link_info[IFLA_INFO_DATA]) parse_can_info(link_info[IFLA_INFO_DATA], status);
+    if (link_info[IFLA_INFO_XSTATS]) {
+        can_device_stats stats;
+        read_attribute(link_info[IFLA_INFO_XSTATS], stats);
+        status.bus_errors = stats.bus_error;
+        status.error_warning = stats.error_warning;
+        status.error_passive = stats.error_passive;
+        status.bus_off = stats.bus_off;
+        status.arbitration_lost = stats.arbitration_lost;
+        status.restarts = stats.restarts;
+    }
+}
+}  // namespace
+
+CANNetlinkException::CANNetlinkException(const std::string& message, int error_code)
+    : std::runtime_error("Netlink error: " + message + ": " + strerror(error_code)),
+      error_code_(error_code) {}
+
+CANInterfaceStatus read_can_interface_status(const std::string& interface) {
+    LinkRequest request(interface, RTM_GETLINK);
+    CANInterfaceStatus status;
+    NetlinkSocket netlink;
+    netlink.transact(request.header(), "status of " + interface,
+                     [&status](const nlmsghdr* message) { parse_link(message, status); });
+    return status;
+}
+
+void restart_can_interface(const std::string& interface) {
+    LinkRequest request(interface, RTM_NEWLINK);
+    size_t link_info = request.begin_nested(IFLA_LINKINFO);
+    request.add_string(IFLA_INFO_KIND, "can");
+    size_t info_data = request.begin_nested(IFLA_INFO_DATA);
+    request.add_u32(IFLA_CAN_RESTART, 1);
+    request.end_nested(info_data);
+    request.end_nested(link_info);
+
+    NetlinkSocket netlink;
+    netlink.transact(request.header(), "restart " + interface);
+}
+
+void set_can_interface_up(const std::string& interface, bool up) {
+    NetlinkSocket netlink;
+    set_up(netlink, interface, up);
+}
+
+void configure_can_interface(const std::string& interface, const CANInterfaceConfig& config) {
+    LinkRequest request(interface, RTM_NEWLINK);
+    size_t link_info = request.begin_nested(IFLA_LINKINFO);
+    request.add_string(IFLA_INFO_KIND, "can");
+    size_t info_data = request.begin_nested(IFLA_INFO_DATA);
+    request.add_struct(IFLA_CAN_BITTIMING,
+                       bit_timing(config.bitrate, config.sample_point, config.sjw));
+    can_ctrlmode mode;
+    mode.mask = CAN_CTRLMODE_FD;
+    mode.flags = config.fd ? CAN_CTRLMODE_FD : 0;
+    request.add_struct(IFLA_CAN_CTRLMODE, mode);
+    if (config.fd) {
+        request.add_struct(
+            IFLA_CAN_DATA_BITTIMING,
+            bit_timing(config.data_bitrate, config.data_sample_point, config.data_sjw));
+    }
+    request.add_u32(IFLA_CAN_RESTART_MS, config.restart_ms);
+    request.end_nested(info_data);
+    request.end_nested(link_info);
+
+    // Bit timing can only change while the interface is down
+    NetlinkSocket netlink;
+    set_up(netlink, interface, false);
+    netlink.transact(request.header(), "configure " + interface);
+    if (config.up) set_up(netlink, interface, true);
+}
+
+CANInterfaceRestarter::CANInterfaceRestarter(const std::string& interface)
+    : interface_(interface) {
+    thread_ = std::thread(&CANInterfaceRestarter::run, this);
+}
+
+CANInterfaceRestarter::~CANInterfaceRestarter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.join();
+}
+
+bool CANInterfaceRestarter::request_restart() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (requested_) return false;
+        requested_ = true;
+    }
+    wakeup_.notify_one();
+    return true;
+}
+
+void CANInterfaceRestarter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wakeup_.wait(lock, [this] { return requested_ || stopping_; });
+        if (stopping_) break;
+        lock.unlock();
+        try {
+            restart_can_interface(interface_);
+            ++restarts_;
+        } catch (const CANNetlinkException& e) {
+            ++failures_;
+            static LogThrottle throttle;
+            Logger::global().log(throttle, LogLevel::ERROR, "CAN restart failed: %s", e.what());
+        }
+        lock.lock();
+        requested_ = false;
+    }
+}
+
+}  // namespace openarm::canbus
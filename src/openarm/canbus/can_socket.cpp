@@ -21,13 +21,28 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <iostream>
 #include <openarm/canbus/can_socket.hpp>
 
 namespace openarm::canbus {
 
-CANSocket::CANSocket(const std::string& interface, bool enable_fd)
-    : socket_fd_(-1), interface_(interface), fd_enabled_(enable_fd) {
+CANSocket::CANSocket(const std::string& interface, bool enable_fd, const CANSocketOptions& options)
+    : socket_fd_(-1), interface_(interface), fd_enabled_(enable_fd), options_(options) {
+    MetricsRegistry& registry = MetricsRegistry::global();
+    MetricLabels labels = {{"interface", interface}};
+    tx_frames_metric_ =
+        &registry.counter("openarm_can_bus_tx_frames_total", "Frames written", labels);
+    tx_errors_metric_ =
+        &registry.counter("openarm_can_bus_tx_errors_total", "Writes the socket refused", labels);
+    rx_frames_metric_ = &registry.counter("openarm_can_bus_rx_frames_total", "Frames read", labels);
+    rx_overflow_metric_ = &registry.counter("openarm_can_bus_rx_overflow_frames_total",
+                                            "Frames the kernel dropped on receive", labels);
+    bus_load_ = std::make_unique<BusLoadEstimator>(
+        options.bus_timing,
+        &registry.gauge("openarm_can_bus_load_ratio",
+                        "Estimated fraction of bus time in use over the last second", labels));
+    error_monitor_.bind_metrics(registry, labels);
     if (!initialize_socket(interface)) {
         throw CANSocketException("Failed to initialize socket for interface: " + interface);
     }
@@ -66,6 +81,38 @@ bool CANSocket::initialize_socket(const std::string& interface) {
         }
     }
 
+    if (options_.send_buffer_size > 0 &&
+        setsockopt(socket_fd_, SOL_SOCKET, SO_SNDBUF, &options_.send_buffer_size,
+                   sizeof(options_.send_buffer_size)) < 0) {
+        cleanup();
+        return false;
+    }
+
+    if (options_.receive_buffer_size > 0 &&
+        setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUF, &options_.receive_buffer_size,
+                   sizeof(options_.receive_buffer_size)) < 0) {
+        cleanup();
+        return false;
+    }
+
+    if (options_.track_rx_overflow) {
+        int enable_rxq_ovfl = 1;
+        if (setsockopt(socket_fd_, SOL_SOCKET, SO_RXQ_OVFL, &enable_rxq_ovfl,
+                       sizeof(enable_rxq_ovfl)) < 0) {
+            cleanup();
+            return false;
+        }
+    }
+
+    if (options_.receive_error_frames) {
+        can_err_mask_t error_mask = CAN_ERR_MASK;
+        if (setsockopt(socket_fd_, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &error_mask,
+                       sizeof(error_mask)) < 0) {
+            cleanup();
+            return false;
+        }
+    }
+
     if (bind(socket_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
         cleanup();
         return false;
@@ -91,36 +138,226 @@ void CANSocket::cleanup() {
 
 ssize_t CANSocket::read_raw_frame(void* buffer, size_t buffer_size) {
     if (!is_initialized()) return -1;
-    return read(socket_fd_, buffer, buffer_size);
+    ssize_t bytes_read = read(socket_fd_, buffer, buffer_size);
+    if (bytes_read > 0) {
+        rx_frames_metric_->inc();
+        record_raw_bus_load(buffer, bytes_read);
+    }
+    return bytes_read;
 }
 
 ssize_t CANSocket::write_raw_frame(const void* buffer, size_t frame_size) {
     if (!is_initialized()) return -1;
-    return write(socket_fd_, buffer, frame_size);
+    ssize_t bytes_written = write(socket_fd_, buffer, frame_size);
+    (bytes_written > 0 ? tx_frames_metric_ : tx_errors_metric_)->inc();
+    if (bytes_written > 0) record_raw_bus_load(buffer, bytes_written);
+    return bytes_written;
+}
+
+void CANSocket::record_raw_bus_load(const void* buffer, ssize_t size) {
+    if (size == CANFD_MTU) {
+        bus_load_->record(static_cast<const canfd_frame*>(buffer), 1);
+    } else if (size == CAN_MTU) {
+        bus_load_->record(static_cast<const can_frame*>(buffer), 1);
+    }
 }
 
 bool CANSocket::write_can_frame(const can_frame& frame) {
-    return write(socket_fd_, &frame, sizeof(frame)) == sizeof(frame);
+    bool success = write(socket_fd_, &frame, sizeof(frame)) == sizeof(frame);
+    (success ? tx_frames_metric_ : tx_errors_metric_)->inc();
+    if (success) bus_load_->record(&frame, 1);
+    if (success && frame_recorder_) frame_recorder_->record(FrameDirection::TX, frame);
+    return success;
 }
 
 bool CANSocket::write_canfd_frame(const canfd_frame& frame) {
-    return write(socket_fd_, &frame, sizeof(frame)) == sizeof(frame);
+    bool success = write(socket_fd_, &frame, sizeof(frame)) == sizeof(frame);
+    (success ? tx_frames_metric_ : tx_errors_metric_)->inc();
+    if (success) bus_load_->record(&frame, 1);
+    if (success && frame_recorder_) frame_recorder_->record(FrameDirection::TX, frame);
+    return success;
+}
+
+int CANSocket::write_can_frames(const can_frame* frames, size_t count) {
+    int sent = write_frames(frames, sizeof(can_frame), count);
+    bus_load_->record(frames, sent);
+    if (frame_recorder_) {
+        for (int i = 0; i < sent; ++i) frame_recorder_->record(FrameDirection::TX, frames[i]);
+    }
+    return sent;
+}
+
+int CANSocket::write_canfd_frames(const canfd_frame* frames, size_t count) {
+    int sent = write_frames(frames, sizeof(canfd_frame), count);
+    bus_load_->record(frames, sent);
+    if (frame_recorder_) {
+        for (int i = 0; i < sent; ++i) frame_recorder_->record(FrameDirection::TX, frames[i]);
+    }
+    return sent;
+}
+
+int CANSocket::write_frames(const void* frames, size_t frame_size, size_t count) {
+    if (!is_initialized()) return 0;
+
+    // Bounded stack buffers keep this path free of allocations
+    constexpr size_t kMaxBatch = 64;
+    struct iovec iovecs[kMaxBatch];
+    struct mmsghdr messages[kMaxBatch];
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(frames);
+    size_t sent = 0;
+    while (sent < count) {
+        size_t batch = std::min(count - sent, kMaxBatch);
+        memset(messages, 0, sizeof(messages[0]) * batch);
+        for (size_t i = 0; i < batch; ++i) {
+            iovecs[i].iov_base = const_cast<uint8_t*>(bytes + (sent + i) * frame_size);
+            iovecs[i].iov_len = frame_size;
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int result = sendmmsg(socket_fd_, messages, batch, 0);
+        if (result <= 0) {
+            tx_errors_metric_->inc();
+            break;
+        }
+        sent += result;
+        if (static_cast<size_t>(result) < batch) {
+            tx_errors_metric_->inc();
+            break;
+        }
+    }
+    tx_frames_metric_->inc(sent);
+    return static_cast<int>(sent);
 }
 
 bool CANSocket::read_can_frame(can_frame& frame) {
     if (!is_initialized()) return false;
-    ssize_t bytes_read = read(socket_fd_, &frame, sizeof(frame));
-    return bytes_read == sizeof(frame);
+    ssize_t bytes_read;
+    // Error frames are consumed here; read on to the next frame behind them
+    do {
+        bytes_read = receive_frame(&frame, sizeof(frame));
+        if (bytes_read > 0) rx_frames_metric_->inc();
+    } while (bytes_read > 0 && consume_error_frame(&frame, bytes_read));
+    if (bytes_read != sizeof(frame)) return false;
+    bus_load_->record(&frame, 1);
+    return true;
 }
 
 bool CANSocket::read_canfd_frame(canfd_frame& frame) {
     if (!is_initialized()) return false;
-    ssize_t bytes_read = read(socket_fd_, &frame, sizeof(frame));
-    return bytes_read == sizeof(frame);
+    ssize_t bytes_read;
+    // Error frames are consumed here; read on to the next frame behind them
+    do {
+        bytes_read = receive_frame(&frame, sizeof(frame));
+        if (bytes_read > 0) rx_frames_metric_->inc();
+    } while (bytes_read > 0 && consume_error_frame(&frame, bytes_read));
+    if (bytes_read != sizeof(frame)) return false;
+    bus_load_->record(&frame, 1);
+    return true;
+}
+
+ssize_t CANSocket::receive_frame(void* frame, size_t frame_size) {
+    if (!options_.track_rx_overflow) {
+        return read(socket_fd_, frame, frame_size);
+    }
+
+    struct iovec iov;
+    iov.iov_base = frame;
+    iov.iov_len = frame_size;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(uint32_t))];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t bytes_read = recvmsg(socket_fd_, &msg, 0);
+    if (bytes_read > 0) update_rx_overflow_count(msg);
+    return bytes_read;
+}
+
+int CANSocket::read_can_frames(can_frame* frames, size_t count) {
+    int received = read_frames(frames, sizeof(can_frame), count);
+    bus_load_->record(frames, received);
+    return received;
+}
+
+int CANSocket::read_canfd_frames(canfd_frame* frames, size_t count) {
+    int received = read_frames(frames, sizeof(canfd_frame), count);
+    bus_load_->record(frames, received);
+    return received;
+}
+
+int CANSocket::read_frames(void* frames, size_t frame_size, size_t count) {
+    if (!is_initialized()) return 0;
+
+    constexpr size_t kMaxBatch = 64;
+    constexpr size_t kControlSize = CMSG_SPACE(sizeof(uint32_t));
+    struct iovec iovecs[kMaxBatch];
+    struct mmsghdr messages[kMaxBatch];
+    alignas(struct cmsghdr) char controls[kMaxBatch][kControlSize];
+
+    size_t batch = std::min(count, kMaxBatch);
+    uint8_t* bytes = static_cast<uint8_t*>(frames);
+
+    // A batch made up only of dropped frames must not look like an empty
+    // socket, or callers stop draining with replies still queued behind it
+    int valid = 0;
+    while (valid == 0) {
+        // recvmmsg() rewrites the headers, so set them up for every call
+        memset(messages, 0, sizeof(messages[0]) * batch);
+        for (size_t i = 0; i < batch; ++i) {
+            iovecs[i].iov_base = bytes + i * frame_size;
+            iovecs[i].iov_len = frame_size;
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            if (options_.track_rx_overflow) {
+                messages[i].msg_hdr.msg_control = controls[i];
+                messages[i].msg_hdr.msg_controllen = kControlSize;
+            }
+        }
+        int received = recvmmsg(socket_fd_, messages, batch, MSG_DONTWAIT, nullptr);
+        if (received <= 0) return 0;
+        rx_frames_metric_->inc(received);
+
+        // Drop error frames and anything that is not a whole frame of the
+        // requested size (e.g. a classic frame on a CAN FD socket read into
+        // canfd_frame slots)
+        for (int i = 0; i < received; ++i) {
+            if (options_.track_rx_overflow) update_rx_overflow_count(messages[i].msg_hdr);
+            if (consume_error_frame(bytes + i * frame_size, messages[i].msg_len)) continue;
+            if (messages[i].msg_len != frame_size) continue;
+            if (valid != i) {
+                memmove(bytes + valid * frame_size, bytes + i * frame_size, frame_size);
+            }
+            ++valid;
+        }
+    }
+    return valid;
+}
+
+bool CANSocket::consume_error_frame(const void* frame, size_t size) {
+    // Error frames are always classic frames, also on CAN FD sockets
+    if (size != CAN_MTU) return false;
+    return error_monitor_.process(*static_cast<const can_frame*>(frame));
+}
+
+void CANSocket::update_rx_overflow_count(msghdr& msg) {
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+            uint32_t previous = rx_overflow_count_;
+            memcpy(&rx_overflow_count_, CMSG_DATA(cmsg), sizeof(rx_overflow_count_));
+            // The kernel count wraps, so the unsigned difference is the increase
+            rx_overflow_metric_->inc(rx_overflow_count_ - previous);
+        }
+    }
 }
 
 bool CANSocket::is_data_available(int timeout_us) {
     if (!is_initialized()) return false;
+    // Called every cycle, so the load estimate also falls while idle
+    bus_load_->update();
 
     fd_set read_fds;
     struct timeval timeout;
@@ -0,0 +1,292 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+
+#include <cstring>
+#include <openarm/canbus/can_tx_scheduler.hpp>
+#include <utility>
+
+namespace openarm::canbus {
+
+namespace {
+bool is_backpressure_error(int error) {
+    return error == ENOBUFS || error == EAGAIN || error == EWOULDBLOCK;
+}
+
+// Indexed by TxPriority
+constexpr uint32_t kDefaultRetryLimits[] = {1000, 2, 100, 0};
+
+uint64_t pack_stop_pending(uint32_t epoch, size_t first) {
+    return (static_cast<uint64_t>(epoch) << 32) | static_cast<uint32_t>(first);
+}
+uint32_t stop_pending_epoch(uint64_t pending) { return static_cast<uint32_t>(pending >> 32); }
+size_t stop_pending_first(uint64_t pending) { return static_cast<uint32_t>(pending); }
+}  // namespace
+
+CANTxScheduler::CANTxScheduler(CANTransport& transport, size_t queue_capacity)
+    : transport_(transport) {
+    for (size_t i = 0; i < queues_.size(); ++i) {
+        queues_[i].ring.resize(queue_capacity > 0 ? queue_capacity : 1);
+        queues_[i].max_retries = kDefaultRetryLimits[i];
+        if (i == static_cast<size_t>(TxPriority::SAFETY)) {
+            queues_[i].coalescing = TxCoalescing::BY_FRAME;
+        } else if (i == static_cast<size_t>(TxPriority::CONTROL)) {
+            queues_[i].coalescing = TxCoalescing::BY_CAN_ID;
+        }
+    }
+}
+
+TxOutcome CANTxScheduler::submit(const can_frame& frame, TxPriority priority,
+                                 std::shared_ptr<CANDevice> owner, TxKind kind) {
+    Entry entry;
+    std::memset(&entry.frame, 0, sizeof(entry.frame));
+    std::memcpy(&entry.frame, &frame, sizeof(frame));
+    entry.is_fd = false;
+    entry.kind = kind;
+    entry.retries = 0;
+    entry.owner = std::move(owner);
+    return enqueue_and_flush(std::move(entry), priority);
+}
+
+TxOutcome CANTxScheduler::submit(const canfd_frame& frame, TxPriority priority,
+                                 std::shared_ptr<CANDevice> owner, TxKind kind) {
+    Entry entry;
+    entry.frame = frame;
+    entry.is_fd = true;
+    entry.kind = kind;
+    entry.retries = 0;
+    entry.owner = std::move(owner);
+    return enqueue_and_flush(std::move(entry), priority);
+}
+
+TxOutcome CANTxScheduler::enqueue_and_flush(Entry entry, TxPriority priority) {
+    entry.sequence = ++next_sequence_;
+    entry.stop_epoch = stop_epoch_.load(std::memory_order_acquire);
+    submitted_sequence_ = entry.sequence;
+    submitted_outcome_ = TxOutcome::QUEUED;
+    enqueue(std::move(entry), priority);
+    flush_queues(false);
+    return submitted_outcome_;
+}
+
+size_t CANTxScheduler::flush() { return flush_queues(true); }
+
+size_t CANTxScheduler::flush_queues(bool count_retry) {
+    size_t written = 0;
+    for (auto& queue : queues_) {
+        while (true) {
+            // Checked before every write, since stop() may interrupt a flush
+            if (!settle_stop(written)) return written;
+            if (queue.size == 0) break;
+            Entry& entry = queue.ring[queue.head];
+            if (!write_entry(entry)) {
+                if (is_backpressure_error(errno)) {
+                    ++queue.stats.backpressure;
+                    if (entry.retries < queue.max_retries) {
+                        // Keep the frame and stop: lower classes must not
+                        // overtake it.
+                        if (count_retry) ++entry.retries;
+                        return written;
+                    }
+                    ++queue.stats.dropped_backpressure;
+                } else {
+                    ++queue.stats.dropped_error;
+                }
+                finish(entry, false);
+            } else {
+                ++queue.stats.sent;
+                ++written;
+                finish(entry, true);
+            }
+            queue.head = (queue.head + 1) % queue.ring.size();
+            --queue.size;
+        }
+    }
+    return written;
+}
+
+bool CANTxScheduler::settle_stop(size_t& written) {
+    uint32_t epoch = stop_epoch_.load(std::memory_order_acquire);
+    if (epoch != discarded_epoch_) {
+        discarded_epoch_ = epoch;
+        discard_stale(queues_[static_cast<size_t>(TxPriority::SAFETY)], epoch);
+        discard_stale(queues_[static_cast<size_t>(TxPriority::CONTROL)], epoch);
+    }
+    uint64_t pending = stop_pending_.load(std::memory_order_acquire);
+    while (pending != 0) {
+        const TxStopFrames* frames = stop_frames_.load(std::memory_order_acquire);
+        size_t first = stop_pending_first(pending);
+        size_t count = write_stop_frames(*frames, first);
+        written += count;
+        if (first + count < stop_frame_count(*frames)) {
+            // Keep the progress unless a newer stop() took over
+            stop_pending_.compare_exchange_strong(
+                pending, pack_stop_pending(stop_pending_epoch(pending), first + count));
+            return false;
+        }
+        // On failure pending holds the newer stop(), which is retried too
+        if (stop_pending_.compare_exchange_strong(pending, 0)) break;
+    }
+    return true;
+}
+
+void CANTxScheduler::discard_stale(Queue& queue, uint32_t epoch) {
+    size_t kept = 0;
+    for (size_t i = 0; i < queue.size; ++i) {
+        Entry& entry = queue.ring[(queue.head + i) % queue.ring.size()];
+        if (entry.kind != TxKind::STOP && entry.stop_epoch != epoch) {
+            ++queue.stats.dropped_stop;
+            finish(entry, false);
+            continue;
+        }
+        if (kept != i) queue.ring[(queue.head + kept) % queue.ring.size()] = std::move(entry);
+        ++kept;
+    }
+    queue.size = kept;
+}
+
+TxStopResult CANTxScheduler::stop() noexcept { return begin_stop(true); }
+
+TxStopResult CANTxScheduler::defer_stop() noexcept { return begin_stop(false); }
+
+TxStopResult CANTxScheduler::begin_stop(bool write) noexcept {
+    uint32_t epoch = stop_epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    TxStopResult result;
+    const TxStopFrames* frames = stop_frames_.load(std::memory_order_acquire);
+    if (!frames) return result;
+    size_t total = stop_frame_count(*frames);
+    size_t count = write ? write_stop_frames(*frames, 0) : 0;
+    result.written = static_cast<int>(count);
+    result.pending = static_cast<int>(total - count);
+    if (count < total) {
+        stop_pending_.store(pack_stop_pending(epoch, count), std::memory_order_release);
+    } else {
+        // Every stop frame is out, which also covers older stops but not a
+        // newer one that raced with this call
+        uint64_t pending = stop_pending_.load(std::memory_order_acquire);
+        while (pending != 0 &&
+               static_cast<int32_t>(stop_pending_epoch(pending) - epoch) < 0 &&
+               !stop_pending_.compare_exchange_weak(pending, 0)) {
+        }
+    }
+    return result;
+}
+
+size_t CANTxScheduler::stop_pending() const {
+    uint64_t pending = stop_pending_.load(std::memory_order_acquire);
+    if (pending == 0) return 0;
+    const TxStopFrames* frames = stop_frames_.load(std::memory_order_acquire);
+    size_t total = stop_frame_count(*frames);
+    size_t first = stop_pending_first(pending);
+    return first < total ? total - first : 0;
+}
+
+size_t CANTxScheduler::write_stop_frames(const TxStopFrames& frames, size_t first) {
+    size_t total = stop_frame_count(frames);
+    if (first >= total) return 0;
+    int count;
+    if (transport_.is_canfd_enabled()) {
+        count = transport_.write_canfd_frames(frames.canfd_frames.data() + first, total - first);
+    } else {
+        count = transport_.write_can_frames(frames.can_frames.data() + first, total - first);
+    }
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+size_t CANTxScheduler::stop_frame_count(const TxStopFrames& frames) const {
+    return transport_.is_canfd_enabled() ? frames.canfd_frames.size() : frames.can_frames.size();
+}
+
+size_t CANTxScheduler::pending() const {
+    size_t total = 0;
+    for (const auto& queue : queues_) total += queue.size;
+    return total;
+}
+
+void CANTxScheduler::enqueue(Entry entry, TxPriority priority) {
+    Queue& queue = queues_[static_cast<size_t>(priority)];
+    if (queue.coalescing != TxCoalescing::NONE) {
+        for (size_t i = 0; i < queue.size; ++i) {
+            Entry& queued = queue.ring[(queue.head + i) % queue.ring.size()];
+            if (!coalesces(queue, queued, entry)) continue;
+            // Keep the queue position and retry count, send the newer frame
+            finish(queued, false);
+            entry.retries = queued.retries;
+            queued = std::move(entry);
+            ++queue.stats.coalesced;
+            return;
+        }
+    }
+    if (queue.size == queue.ring.size()) {
+        size_t victim = queue.size;
+        if (entry.kind == TxKind::STOP) {
+            for (size_t i = 0; i < queue.size; ++i) {
+                if (queue.ring[(queue.head + i) % queue.ring.size()].kind != TxKind::STOP) {
+                    victim = i;
+                    break;
+                }
+            }
+        }
+        if (victim == queue.size) {
+            ++queue.stats.dropped_overflow;
+            finish(entry, false);
+            return;
+        }
+        evict(queue, victim);
+        ++queue.stats.evicted;
+    }
+    queue.ring[(queue.head + queue.size) % queue.ring.size()] = std::move(entry);
+    ++queue.size;
+}
+
+bool CANTxScheduler::coalesces(const Queue& queue, const Entry& queued, const Entry& entry) {
+    if (queued.frame.can_id != entry.frame.can_id || queued.is_fd != entry.is_fd) return false;
+    if (queued.kind == TxKind::STOP && entry.kind != TxKind::STOP) return false;
+    if (queue.coalescing == TxCoalescing::BY_FRAME) {
+        // can_frame's can_dlc shares the offset of canfd_frame's len
+        return queued.frame.len == entry.frame.len &&
+               std::memcmp(queued.frame.data, entry.frame.data, entry.frame.len) == 0;
+    }
+    return true;
+}
+
+void CANTxScheduler::evict(Queue& queue, size_t index) {
+    finish(queue.ring[(queue.head + index) % queue.ring.size()], false);
+    // Close the gap so the remaining frames keep their order
+    for (size_t i = index; i + 1 < queue.size; ++i) {
+        queue.ring[(queue.head + i) % queue.ring.size()] =
+            std::move(queue.ring[(queue.head + i + 1) % queue.ring.size()]);
+    }
+    --queue.size;
+}
+
+void CANTxScheduler::finish(Entry& entry, bool sent) {
+    if (entry.owner) {
+        entry.owner->record_tx(sent);
+        entry.owner.reset();
+    }
+    if (entry.sequence == submitted_sequence_) {
+        submitted_outcome_ = sent ? TxOutcome::SENT : TxOutcome::DROPPED;
+    }
+}
+
+bool CANTxScheduler::write_entry(const Entry& entry) {
+    if (entry.is_fd) {
+        return transport_.write_canfd_frame(entry.frame);
+    }
+    return transport_.write_can_frame(reinterpret_cast<const can_frame&>(entry.frame));
+}
+
+}  // namespace openarm::canbus
@@ -0,0 +1,51 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <openarm/canbus/cycle_stats.hpp>
+
+namespace openarm::canbus {
+
+const char* to_string(CyclePhase phase) {
+    switch (phase) {
+        case CyclePhase::ENCODE:
+            return "encode";
+        case CyclePhase::TX:
+            return "tx";
+        case CyclePhase::WAIT_FIRST_REPLY:
+            return "wait_first_reply";
+        case CyclePhase::DRAIN:
+            return "drain";
+        case CyclePhase::DECODE:
+            return "decode";
+    }
+    return "unknown";
+}
+
+void CycleStats::end_cycle() {
+    for (size_t i = 0; i < kCyclePhaseCount; ++i) {
+        last_ns_[i] = pending_ns_[i];
+        histograms_[i].record(static_cast<uint64_t>(pending_ns_[i]));
+        pending_ns_[i] = 0;
+    }
+    ++cycles_;
+}
+
+void CycleStats::reset() {
+    pending_ns_.fill(0);
+    last_ns_.fill(0);
+    for (auto& histogram : histograms_) histogram.reset();
+    cycles_ = 0;
+}
+
+}  // namespace openarm::canbus
@@ -0,0 +1,269 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <openarm/canbus/fault_injection_transport.hpp>
+#include <openarm/canbus/frame_recorder.hpp>
+
+namespace openarm::canbus {
+
+namespace {
+
+// A held frame is released on its own if no other frame passes in time
+constexpr int64_t kReorderHoldNs = 1000000;
+
+int64_t monotonic_now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+canfd_frame to_canfd_frame(const can_frame& frame) {
+    canfd_frame fd_frame;
+    std::memset(&fd_frame, 0, sizeof(fd_frame));
+    std::memcpy(&fd_frame, &frame, sizeof(frame));
+    return fd_frame;
+}
+
+}  // namespace
+
+FaultInjectionTransport::FaultInjectionTransport(CANTransport& inner, uint64_t seed)
+    : inner_(inner), rng_(seed) {}
+
+void FaultInjectionTransport::set_tx_profile(const FaultProfile& profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tx_.profile = profile;
+}
+
+void FaultInjectionTransport::set_rx_profile(const FaultProfile& profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rx_.profile = profile;
+}
+
+FaultStats FaultInjectionTransport::get_tx_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tx_.stats;
+}
+
+FaultStats FaultInjectionTransport::get_rx_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rx_.stats;
+}
+
+int FaultInjectionTransport::write_can_frames(const can_frame* frames, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t now_ns = monotonic_now_ns();
+    size_t written = 0;
+    for (; written < count && !refuse_tx(); ++written) {
+        // Recorded as written by the caller, before any fault is applied
+        if (frame_recorder_) frame_recorder_->record(FrameDirection::TX, frames[written]);
+        apply_faults(tx_, to_canfd_frame(frames[written]), false, now_ns);
+    }
+    flush_tx(now_ns);
+    if (written < count) errno = ENOBUFS;
+    return static_cast<int>(written);
+}
+
+int FaultInjectionTransport::write_canfd_frames(const canfd_frame* frames, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t now_ns = monotonic_now_ns();
+    size_t written = 0;
+    for (; written < count && !refuse_tx(); ++written) {
+        if (frame_recorder_) frame_recorder_->record(FrameDirection::TX, frames[written]);
+        apply_faults(tx_, frames[written], true, now_ns);
+    }
+    flush_tx(now_ns);
+    if (written < count) errno = ENOBUFS;
+    return static_cast<int>(written);
+}
+
+int FaultInjectionTransport::read_can_frames(can_frame* frames, size_t count) {
+    return read_frames(frames, count, false);
+}
+
+int FaultInjectionTransport::read_canfd_frames(canfd_frame* frames, size_t count) {
+    return read_frames(frames, count, true);
+}
+
+bool FaultInjectionTransport::is_data_available(int timeout_us) {
+    const int64_t deadline_ns = monotonic_now_ns() + static_cast<int64_t>(timeout_us) * 1000;
+    while (true) {
+        int64_t now_ns = monotonic_now_ns();
+        int64_t wait_ns = deadline_ns - now_ns;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pump_rx(now_ns);
+            flush_tx(now_ns);
+            if (!rx_.pending.empty() && rx_.pending.front().due_ns <= now_ns) return true;
+            wait_ns = std::min(wait_ns, next_due_ns() - now_ns);
+        }
+        if (now_ns >= deadline_ns) return false;
+        // Wake up for new inner frames or for the next delayed frame
+        inner_.is_data_available(static_cast<int>(std::max<int64_t>(1, wait_ns / 1000)));
+    }
+}
+
+bool FaultInjectionTransport::refuse_tx() {
+    double probability = tx_.profile.refuse_probability;
+    if (probability <= 0 || std::uniform_real_distribution<double>(0.0, 1.0)(rng_) >= probability) {
+        return false;
+    }
+    ++tx_.stats.refused;
+    return true;
+}
+
+void FaultInjectionTransport::apply_faults(Direction& direction, const canfd_frame& frame,
+                                           bool is_fd, int64_t now_ns) {
+    const FaultProfile& profile = direction.profile;
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+    if (profile.drop_probability > 0 && chance(rng_) < profile.drop_probability) {
+        ++direction.stats.dropped;
+        return;
+    }
+
+    Entry entry{now_ns, frame, is_fd};
+    if (profile.corrupt_probability > 0 && frame.len > 0 &&
+        chance(rng_) < profile.corrupt_probability) {
+        std::uniform_int_distribution<int> bit(0, frame.len * 8 - 1);
+        int flipped = bit(rng_);
+        entry.frame.data[flipped / 8] ^= static_cast<uint8_t>(1u << (flipped % 8));
+        ++direction.stats.corrupted;
+    }
+
+    int64_t delay_us = profile.delay_us;
+    if (profile.delay_jitter_us > 0) {
+        delay_us += std::uniform_int_distribution<int>(0, profile.delay_jitter_us)(rng_);
+    }
+    if (delay_us > 0) {
+        entry.due_ns += delay_us * 1000;
+        ++direction.stats.delayed;
+    }
+
+    int copies = 1;
+    if (profile.duplicate_probability > 0 && chance(rng_) < profile.duplicate_probability) {
+        copies = 2;
+        ++direction.stats.duplicated;
+    }
+
+    for (int i = 0; i < copies; ++i) {
+        if (!direction.held && profile.reorder_probability > 0 &&
+            chance(rng_) < profile.reorder_probability) {
+            direction.held = entry;
+            direction.held_since_ns = now_ns;
+            ++direction.stats.reordered;
+            continue;
+        }
+        enqueue(direction, entry);
+        // The held frame goes out right behind the one that overtook it
+        release_held(direction, now_ns, true);
+    }
+}
+
+void FaultInjectionTransport::enqueue(Direction& direction, Entry entry) {
+    // Stable insert by due time; jitter alone can reorder frames
+    auto it = direction.pending.end();
+    while (it != direction.pending.begin() && std::prev(it)->due_ns > entry.due_ns) --it;
+    direction.pending.insert(it, entry);
+    ++direction.stats.passed;
+}
+
+void FaultInjectionTransport::release_held(Direction& direction, int64_t now_ns, bool force) {
+    if (!direction.held) return;
+    if (!force && now_ns - direction.held_since_ns < kReorderHoldNs) return;
+    Entry entry = *direction.held;
+    direction.held.reset();
+    if (!direction.pending.empty()) {
+        entry.due_ns = std::max(entry.due_ns, direction.pending.back().due_ns);
+    }
+    enqueue(direction, entry);
+}
+
+void FaultInjectionTransport::flush_tx(int64_t now_ns) {
+    release_held(tx_, now_ns, false);
+    while (!tx_.pending.empty() && tx_.pending.front().due_ns <= now_ns) {
+        const Entry& entry = tx_.pending.front();
+        bool written;
+        if (entry.is_fd) {
+            written = inner_.write_canfd_frame(entry.frame);
+        } else {
+            can_frame frame;
+            std::memcpy(&frame, &entry.frame, sizeof(frame));
+            written = inner_.write_can_frame(frame);
+        }
+        if (!written) ++tx_.stats.write_failures;
+        tx_.pending.pop_front();
+    }
+}
+
+void FaultInjectionTransport::pump_rx(int64_t now_ns) {
+    constexpr size_t kBatchSize = 32;
+    if (inner_.is_canfd_enabled()) {
+        canfd_frame frames[kBatchSize];
+        int count;
+        while ((count = inner_.read_canfd_frames(frames, kBatchSize)) > 0) {
+            for (int i = 0; i < count; ++i) apply_faults(rx_, frames[i], true, now_ns);
+        }
+    } else {
+        can_frame frames[kBatchSize];
+        int count;
+        while ((count = inner_.read_can_frames(frames, kBatchSize)) > 0) {
+            for (int i = 0; i < count; ++i) {
+                apply_faults(rx_, to_canfd_frame(frames[i]), false, now_ns);
+            }
+        }
+    }
+    release_held(rx_, now_ns, false);
+}
+
+int64_t FaultInjectionTransport::next_due_ns() const {
+    int64_t next_ns = std::numeric_limits<int64_t>::max();
+    for (const Direction* direction : {&tx_, &rx_}) {
+        if (!direction->pending.empty()) {
+            next_ns = std::min(next_ns, direction->pending.front().due_ns);
+        }
+        if (direction->held) {
+            next_ns = std::min(next_ns, direction->held_since_ns + kReorderHoldNs);
+        }
+    }
+    return next_ns;
+}
+
+template <typename Frame>
+int FaultInjectionTransport::read_frames(Frame* frames, size_t count, bool want_fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t now_ns = monotonic_now_ns();
+    pump_rx(now_ns);
+    flush_tx(now_ns);
+
+    size_t read_count = 0;
+    while (read_count < count && !rx_.pending.empty() && rx_.pending.front().due_ns <= now_ns) {
+        const Entry& entry = rx_.pending.front();
+        // A classic socket never sees CAN FD frames
+        if (want_fd || !entry.is_fd) {
+            std::memcpy(&frames[read_count], &entry.frame, sizeof(Frame));
+            ++read_count;
+        }
+        rx_.pending.pop_front();
+    }
+    return static_cast<int>(read_count);
+}
+
+}  // namespace openarm::canbus
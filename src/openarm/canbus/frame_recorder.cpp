@@ -0,0 +1,227 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+
+#include <chrono>
+#include <cstring>
+#include <openarm/canbus/frame_recorder.hpp>
+#include <stdexcept>
+
+namespace openarm::canbus {
+
+namespace {
+constexpr char kMagic[8] = {'O', 'A', 'C', 'A', 'N', 'L', 'O', 'G'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kRecordHeaderSize = 16;
+
+uint64_t realtime_now_ns() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+void put_le(uint8_t* out, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t get_le(const uint8_t* in, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+FILE* open_or_throw(const std::string& path, const char* mode) {
+    FILE* file = fopen(path.c_str(), mode);
+    if (!file) throw std::runtime_error("Failed to open frame log: " + path);
+    return file;
+}
+}  // namespace
+
+FrameRecorder::FrameRecorder(const std::string& interface, const FrameRecorderOptions& options)
+    : interface_(interface), options_(options), queue_(options.ring_capacity) {
+    if (!options_.binary_path.empty()) {
+        binary_file_ = open_or_throw(options_.binary_path, "wb");
+        uint8_t header[16];
+        std::memcpy(header, kMagic, sizeof(kMagic));
+        put_le(header + 8, kVersion, 4);
+        put_le(header + 12, interface_.size(), 4);
+        fwrite(header, 1, sizeof(header), binary_file_);
+        fwrite(interface_.data(), 1, interface_.size(), binary_file_);
+    }
+    if (!options_.text_path.empty()) {
+        try {
+            text_file_ = open_or_throw(options_.text_path, "w");
+        } catch (...) {
+            if (binary_file_) fclose(binary_file_);
+            throw;
+        }
+    }
+
+    thread_ = std::thread(&FrameRecorder::run, this);
+}
+
+FrameRecorder::~FrameRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.join();
+    if (binary_file_) fclose(binary_file_);
+    if (text_file_) fclose(text_file_);
+}
+
+void FrameRecorder::record(FrameDirection direction, const can_frame& frame) noexcept {
+    uint8_t len = frame.can_dlc > CAN_MAX_DLEN ? CAN_MAX_DLEN : frame.can_dlc;
+    push(direction, frame.can_id, false, 0, len, frame.data);
+}
+
+void FrameRecorder::record(FrameDirection direction, const canfd_frame& frame) noexcept {
+    uint8_t len = frame.len > CANFD_MAX_DLEN ? CANFD_MAX_DLEN : frame.len;
+    push(direction, frame.can_id, true, frame.flags, len, frame.data);
+}
+
+void FrameRecorder::push(FrameDirection direction, canid_t can_id, bool is_fd, uint8_t flags,
+                         uint8_t len, const uint8_t* data) noexcept {
+    uint64_t timestamp_ns = realtime_now_ns();
+    bool queued = queue_.try_push([&](RecordedFrame& recorded) {
+        recorded.timestamp_ns = timestamp_ns;
+        recorded.can_id = can_id;
+        recorded.direction = direction;
+        recorded.is_fd = is_fd;
+        recorded.flags = flags;
+        recorded.len = len;
+        std::memcpy(recorded.data, data, len);
+    });
+    if (!queued) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    recorded_.fetch_add(1, std::memory_order_release);
+}
+
+size_t FrameRecorder::drain() {
+    size_t count = 0;
+    while (queue_.try_pop([this](const RecordedFrame& frame) {
+        if (binary_file_) write_binary(frame);
+        if (text_file_) write_text(frame);
+    })) {
+        ++count;
+    }
+    return count;
+}
+
+void FrameRecorder::write_binary(const RecordedFrame& frame) {
+    uint8_t record[kRecordHeaderSize + CANFD_MAX_DLEN];
+    put_le(record, frame.timestamp_ns, 8);
+    put_le(record + 8, frame.can_id, 4);
+    record[12] = static_cast<uint8_t>(frame.direction);
+    record[13] = frame.is_fd ? 1 : 0;
+    record[14] = frame.flags;
+    record[15] = frame.len;
+    std::memcpy(record + kRecordHeaderSize, frame.data, frame.len);
+    fwrite(record, 1, kRecordHeaderSize + frame.len, binary_file_);
+}
+
+void FrameRecorder::write_text(const RecordedFrame& frame) {
+    // (seconds.microseconds) interface ID#DATA, or ID##<flags>DATA for CAN FD
+    char line[256];
+    unsigned long long seconds = frame.timestamp_ns / 1000000000ULL;
+    unsigned long long microseconds = frame.timestamp_ns % 1000000000ULL / 1000;
+    int length = snprintf(line, sizeof(line), "(%llu.%06llu) %.64s ", seconds, microseconds,
+                          interface_.c_str());
+    if (length < 0 || static_cast<size_t>(length) >= sizeof(line)) return;
+    if (frame.can_id & (CAN_EFF_FLAG | CAN_ERR_FLAG)) {
+        length += snprintf(line + length, sizeof(line) - length, "%08X",
+                           frame.can_id & (CAN_EFF_MASK | CAN_ERR_FLAG));
+    } else {
+        length +=
+            snprintf(line + length, sizeof(line) - length, "%03X", frame.can_id & CAN_SFF_MASK);
+    }
+    if (frame.is_fd) {
+        length += snprintf(line + length, sizeof(line) - length, "##%X", frame.flags & 0xF);
+    } else if (frame.can_id & CAN_RTR_FLAG) {
+        length += snprintf(line + length, sizeof(line) - length, "#R");
+    } else {
+        line[length++] = '#';
+    }
+    static const char kHex[] = "0123456789ABCDEF";
+    for (uint8_t i = 0; i < frame.len; ++i) {
+        line[length++] = kHex[frame.data[i] >> 4];
+        line[length++] = kHex[frame.data[i] & 0xF];
+    }
+    line[length++] = '\n';
+    fwrite(line, 1, length, text_file_);
+}
+
+void FrameRecorder::flush() {
+    uint64_t target = recorded_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex_);
+    flush_requested_ = true;
+    wakeup_.notify_one();
+    drained_.wait(lock, [this, target] { return written_ >= target || stopping_; });
+}
+
+void FrameRecorder::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        lock.unlock();
+        size_t count = drain();
+        lock.lock();
+        written_ += count;
+        if (count > 0 || flush_requested_) {
+            if (binary_file_) fflush(binary_file_);
+            if (text_file_) fflush(text_file_);
+            flush_requested_ = false;
+            drained_.notify_all();
+        }
+        if (stopping_ && written_ >= recorded_.load(std::memory_order_acquire)) break;
+        // Producers never signal, so recording stays free of system calls
+        wakeup_.wait_for(lock, std::chrono::milliseconds(options_.drain_interval_ms));
+    }
+}
+
+FrameLogReader::FrameLogReader(const std::string& path) : file_(fopen(path.c_str(), "rb")) {
+    if (!file_) throw std::runtime_error("Failed to open frame log: " + path);
+    uint8_t header[16];
+    if (fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        std::memcmp(header, kMagic, sizeof(kMagic)) != 0 || get_le(header + 8, 4) != kVersion) {
+        fclose(file_);
+        throw std::runtime_error("Not a frame log: " + path);
+    }
+    interface_.resize(get_le(header + 12, 4));
+    if (fread(&interface_[0], 1, interface_.size(), file_) != interface_.size()) {
+        fclose(file_);
+        throw std::runtime_error("Truncated frame log: " + path);
+    }
+}
+
+FrameLogReader::~FrameLogReader() { fclose(file_); }
+
+bool FrameLogReader::next(RecordedFrame& frame) {
+    uint8_t header[kRecordHeaderSize];
+    if (fread(header, 1, sizeof(header), file_) != sizeof(header)) return false;
+    frame.timestamp_ns = get_le(header, 8);
+    frame.can_id = static_cast<canid_t>(get_le(header + 8, 4));
+    frame.direction = static_cast<FrameDirection>(header[12]);
+    frame.is_fd = header[13] != 0;
+    frame.flags = header[14];
+    // Later records cannot be located once a length is wrong, so stop here
+    if (header[15] > CANFD_MAX_DLEN) return false;
+    frame.len = header[15];
+    return fread(frame.data, 1, frame.len, file_) == frame.len;
+}
+
+}  // namespace openarm::canbus
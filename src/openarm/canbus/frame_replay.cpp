@@ -0,0 +1,189 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <openarm/canbus/frame_replay.hpp>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace openarm::canbus {
+
+namespace {
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// "(1436509052.249713) can0 123#DEADBEEF", "... 123##1DEADBEEF" or "123#R"
+bool parse_candump_line(const std::string& line, RecordedFrame& frame) {
+    unsigned long long seconds = 0;
+    unsigned long long microseconds = 0;
+    char interface[64];
+    char body[256];
+    if (sscanf(line.c_str(), " (%llu.%llu) %63s %255s", &seconds, &microseconds, interface,
+               body) != 4) {
+        return false;
+    }
+
+    std::memset(&frame, 0, sizeof(frame));
+    frame.timestamp_ns = seconds * 1000000000ULL + microseconds * 1000ULL;
+    frame.direction = FrameDirection::RX;
+
+    const char* separator = std::strchr(body, '#');
+    if (!separator) return false;
+    size_t id_length = separator - body;
+    if (id_length == 0 || id_length > 8) return false;
+    canid_t can_id = 0;
+    for (size_t i = 0; i < id_length; ++i) {
+        int value = hex_value(body[i]);
+        if (value < 0) return false;
+        can_id = (can_id << 4) | value;
+    }
+    // candump writes 8 digit IDs for extended and error frames
+    if (id_length == 8 && !(can_id & CAN_ERR_FLAG)) can_id |= CAN_EFF_FLAG;
+    frame.can_id = can_id;
+
+    const char* data = separator + 1;
+    size_t max_len = CAN_MAX_DLEN;
+    if (*data == '#') {
+        int flags = hex_value(data[1]);
+        if (flags < 0) return false;
+        frame.is_fd = true;
+        frame.flags = static_cast<uint8_t>(flags);
+        max_len = CANFD_MAX_DLEN;
+        data += 2;
+    } else if (*data == 'R' || *data == 'r') {
+        frame.can_id |= CAN_RTR_FLAG;
+        return true;
+    }
+    // Whole bytes only, optionally separated by '.' as cansend accepts
+    while (*data != '\0') {
+        if (*data == '.') {
+            ++data;
+            continue;
+        }
+        int high = hex_value(data[0]);
+        int low = hex_value(data[1]);  // '\0' for a dangling nibble
+        if (high < 0 || low < 0 || frame.len >= max_len) return false;
+        frame.data[frame.len++] = static_cast<uint8_t>((high << 4) | low);
+        data += 2;
+    }
+    return true;
+}
+
+std::vector<RecordedFrame> read_candump_log(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Failed to open frame log: " + path);
+    std::vector<RecordedFrame> frames;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        RecordedFrame frame;
+        if (!parse_candump_line(line, frame)) {
+            throw std::runtime_error("Invalid candump line " + std::to_string(line_number) +
+                                     " in " + path);
+        }
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+template <typename Frame>
+void dispatch(CANDeviceCollection& collection, const RecordedFrame& recorded, size_t max_len) {
+    Frame frame;
+    std::memset(&frame, 0, sizeof(frame));
+    frame.can_id = recorded.can_id;
+    uint8_t len = recorded.len > max_len ? static_cast<uint8_t>(max_len) : recorded.len;
+    std::memcpy(frame.data, recorded.data, len);
+    if constexpr (std::is_same_v<Frame, canfd_frame>) {
+        frame.len = len;
+        frame.flags = recorded.flags;
+    } else {
+        frame.can_dlc = len;
+    }
+    collection.dispatch_frame_callback(frame);
+}
+}  // namespace
+
+std::vector<RecordedFrame> read_frame_log(const std::string& path) {
+    char magic[8] = {};
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("Failed to open frame log: " + path);
+        file.read(magic, sizeof(magic));
+    }
+    if (std::memcmp(magic, "OACANLOG", sizeof(magic)) != 0) return read_candump_log(path);
+
+    FrameLogReader reader(path);
+    std::vector<RecordedFrame> frames;
+    RecordedFrame frame;
+    while (reader.next(frame)) frames.push_back(frame);
+    return frames;
+}
+
+ReplayStats replay_frames(const std::vector<RecordedFrame>& frames,
+                          CANDeviceCollection& collection, const ReplayOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    ReplayStats stats;
+    const bool paced = options.speed > 0;
+    const bool fd_enabled = collection.get_transport().is_canfd_enabled();
+    const auto start = Clock::now();
+    const uint64_t first_timestamp_ns = frames.empty() ? 0 : frames.front().timestamp_ns;
+
+    for (const RecordedFrame& recorded : frames) {
+        if (recorded.direction == FrameDirection::TX && !options.include_tx) {
+            ++stats.frames_skipped;
+            continue;
+        }
+        if (paced) {
+            // Timestamps are wall clock; a step backwards replays at once
+            uint64_t offset_ns = recorded.timestamp_ns > first_timestamp_ns
+                                     ? recorded.timestamp_ns - first_timestamp_ns
+                                     : 0;
+            auto due = start + std::chrono::nanoseconds(
+                                   static_cast<int64_t>(offset_ns / options.speed));
+            auto now = Clock::now();
+            if (due > now) {
+                std::this_thread::sleep_until(due);
+                now = Clock::now();
+            }
+            int64_t lag_ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count();
+            if (lag_ns > stats.max_lag_ns) stats.max_lag_ns = lag_ns;
+        }
+        // A CAN FD stack takes every frame as canfd_frame; a classic one never
+        // sees CAN FD frames
+        if (fd_enabled) {
+            dispatch<canfd_frame>(collection, recorded, CANFD_MAX_DLEN);
+        } else if (!recorded.is_fd) {
+            dispatch<can_frame>(collection, recorded, CAN_MAX_DLEN);
+        } else {
+            ++stats.frames_skipped;
+            continue;
+        }
+        ++stats.frames_dispatched;
+    }
+    stats.elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+    return stats;
+}
+
+}  // namespace openarm::canbus
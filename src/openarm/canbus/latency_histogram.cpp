@@ -0,0 +1,70 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <openarm/canbus/latency_histogram.hpp>
+
+namespace openarm::canbus {
+
+size_t LatencyHistogram::bucket_index(uint64_t value_ns) {
+    if (value_ns < kLinearLimit) return static_cast<size_t>(value_ns);
+    // exponent >= kSubBucketBits + 1; keep the kSubBucketBits bits below the top bit
+    int exponent = 63 - __builtin_clzll(value_ns);
+    uint64_t sub_bucket = (value_ns >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+    return kLinearLimit + (exponent - kSubBucketBits - 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index) {
+    if (index < kLinearLimit) return index;
+    size_t offset = index - kLinearLimit;
+    int exponent = static_cast<int>(offset / kSubBucketCount) + kSubBucketBits + 1;
+    uint64_t sub_bucket = offset % kSubBucketCount;
+    int shift = exponent - kSubBucketBits;
+    uint64_t lower = ((kSubBucketCount + sub_bucket) << shift);
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+    ++buckets_[bucket_index(value_ns)];
+    ++count_;
+    sum_ += value_ns;
+    min_ = std::min(min_, value_ns);
+    max_ = std::max(max_, value_ns);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) buckets_[i] += other.buckets_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset() { *this = LatencyHistogram(); }
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (count_ == 0) return 0;
+    percent = std::max(0.0, std::min(percent, 100.0));
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percent / 100.0 * count_));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) return std::min(bucket_upper_bound(i), max_);
+    }
+    return max_;
+}
+
+}  // namespace openarm::canbus
@@ -0,0 +1,161 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <time.h>
+
+#include <chrono>
+#include <openarm/canbus/log.hpp>
+
+namespace openarm::canbus {
+
+namespace {
+int64_t monotonic_now_ns() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void write_to_stderr(LogLevel level, const char* message) {
+    fprintf(stderr, "%s: %s\n", to_string(level), message);
+}
+}  // namespace
+
+const char* to_string(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG:
+            return "DEBUG";
+        case LogLevel::INFO:
+            return "INFO";
+        case LogLevel::WARNING:
+            return "WARNING";
+        case LogLevel::ERROR:
+            return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+bool LogThrottle::allow(uint64_t& suppressed) noexcept {
+    int64_t now_ns = monotonic_now_ns();
+    int64_t next_ns = next_allowed_ns_.load(std::memory_order_relaxed);
+    if (now_ns < next_ns ||
+        !next_allowed_ns_.compare_exchange_strong(next_ns, now_ns + interval_ns_,
+                                                  std::memory_order_relaxed)) {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+Logger& Logger::global() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger(MetricsRegistry& registry)
+    : queue_(kQueueSize),
+      messages_(registry.counter("openarm_can_log_messages_total", "Messages queued for the sink")),
+      suppressed_(registry.counter("openarm_can_log_suppressed_total",
+                                   "Messages dropped by a per-site rate limit")),
+      dropped_(registry.counter("openarm_can_log_dropped_total",
+                                "Messages dropped because the queue was full")),
+      sink_(write_to_stderr) {
+    thread_ = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.join();
+}
+
+void Logger::set_sink(LogSink sink) {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    sink_ = sink ? std::move(sink) : LogSink(write_to_stderr);
+}
+
+void Logger::log(LogLevel level, const char* format, ...) noexcept {
+    if (level < get_level()) return;
+    va_list args;
+    va_start(args, format);
+    enqueue(level, 0, format, args);
+    va_end(args);
+}
+
+void Logger::log(LogThrottle& throttle, LogLevel level, const char* format, ...) noexcept {
+    if (level < get_level()) return;
+    uint64_t suppressed = 0;
+    if (!throttle.allow(suppressed)) {
+        suppressed_.inc();
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    enqueue(level, suppressed, format, args);
+    va_end(args);
+}
+
+void Logger::enqueue(LogLevel level, uint64_t suppressed, const char* format,
+                     va_list args) noexcept {
+    bool queued = queue_.try_push([&](Entry& entry) {
+        entry.level = level;
+        int length = vsnprintf(entry.message, kMaxMessageLength, format, args);
+        if (suppressed > 0 && length >= 0 && static_cast<size_t>(length) < kMaxMessageLength) {
+            snprintf(entry.message + length, kMaxMessageLength - length,
+                     " (%llu similar message(s) suppressed)",
+                     static_cast<unsigned long long>(suppressed));
+        }
+    });
+    if (!queued) {
+        dropped_.inc();
+        return;
+    }
+    messages_.inc();
+    enqueued_.fetch_add(1, std::memory_order_release);
+    wakeup_.notify_one();
+}
+
+void Logger::flush() {
+    uint64_t target = enqueued_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex_);
+    wakeup_.notify_one();
+    drained_.wait(lock, [this, target] { return delivered_ >= target || stopping_; });
+}
+
+void Logger::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        lock.unlock();
+        uint64_t delivered = 0;
+        {
+            std::lock_guard<std::mutex> sink_lock(sink_mutex_);
+            while (queue_.try_pop([this](Entry& entry) { sink_(entry.level, entry.message); })) {
+                ++delivered;
+            }
+        }
+        lock.lock();
+        delivered_ += delivered;
+        drained_.notify_all();
+        if (stopping_ && enqueued_.load(std::memory_order_acquire) <= delivered_) break;
+        // Producers notify without the lock, so a wakeup can be missed; the
+        // timeout bounds how long a message may wait.
+        wakeup_.wait_for(lock, std::chrono::milliseconds(100));
+    }
+}
+
+}  // namespace openarm::canbus
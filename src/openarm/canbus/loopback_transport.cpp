@@ -0,0 +1,164 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <openarm/canbus/can_socket.hpp>
+#include <openarm/canbus/frame_recorder.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <utility>
+
+namespace openarm::canbus {
+
+LoopbackTransport::LoopbackTransport(bool enable_fd, const std::string& interface)
+    : interface_(interface), fd_enabled_(enable_fd) {
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0) {
+        throw CANSocketException("Failed to create eventfd for loopback transport");
+    }
+}
+
+LoopbackTransport::~LoopbackTransport() {
+    if (peer_) peer_->peer_ = nullptr;
+    close(event_fd_);
+}
+
+void LoopbackTransport::connect(LoopbackTransport& a, LoopbackTransport& b) {
+    a.peer_ = &b;
+    b.peer_ = &a;
+}
+
+void LoopbackTransport::set_tx_handler(TxHandler tx_handler) {
+    tx_handler_ = std::move(tx_handler);
+}
+
+void LoopbackTransport::inject(const can_frame& frame) {
+    Entry entry;
+    std::memset(&entry.frame, 0, sizeof(entry.frame));
+    std::memcpy(&entry.frame, &frame, sizeof(frame));
+    entry.is_fd = false;
+    push(entry);
+}
+
+void LoopbackTransport::inject(const canfd_frame& frame) { push({frame, true}); }
+
+size_t LoopbackTransport::rx_pending() const {
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    return rx_queue_.size();
+}
+
+int LoopbackTransport::write_can_frames(const can_frame* frames, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Entry entry;
+        std::memset(&entry.frame, 0, sizeof(entry.frame));
+        std::memcpy(&entry.frame, &frames[i], sizeof(frames[i]));
+        entry.is_fd = false;
+        if (frame_recorder_) frame_recorder_->record(FrameDirection::TX, frames[i]);
+        deliver(entry);
+    }
+    return static_cast<int>(count);
+}
+
+int LoopbackTransport::write_canfd_frames(const canfd_frame* frames, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (frame_recorder_) frame_recorder_->record(FrameDirection::TX, frames[i]);
+        deliver({frames[i], true});
+    }
+    return static_cast<int>(count);
+}
+
+int LoopbackTransport::read_can_frames(can_frame* frames, size_t count) {
+    return read_frames(frames, count, false);
+}
+
+int LoopbackTransport::read_canfd_frames(canfd_frame* frames, size_t count) {
+    return read_frames(frames, count, true);
+}
+
+bool LoopbackTransport::is_data_available(int timeout_us) {
+    {
+        std::lock_guard<std::mutex> lock(rx_mutex_);
+        if (!rx_queue_.empty()) return true;
+    }
+    if (timeout_us <= 0) return false;
+
+    struct pollfd pfd;
+    pfd.fd = event_fd_;
+    pfd.events = POLLIN;
+    struct timespec timeout;
+    timeout.tv_sec = timeout_us / 1000000;
+    timeout.tv_nsec = (timeout_us % 1000000) * 1000L;
+    return ppoll(&pfd, 1, &timeout, nullptr) > 0;
+}
+
+void LoopbackTransport::deliver(const Entry& entry) {
+    if (tx_handler_) {
+        tx_handler_(entry.frame, entry.is_fd);
+    } else if (peer_) {
+        peer_->push(entry);
+    }
+    // Without a handler or peer the frame is lost, like on an empty bus
+}
+
+void LoopbackTransport::push(const Entry& entry) {
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    rx_queue_.push_back(entry);
+    // Signal only on the empty -> non-empty edge to keep writes syscall free
+    if (rx_queue_.size() == 1) {
+        uint64_t one = 1;
+        (void)!write(event_fd_, &one, sizeof(one));
+    }
+}
+
+template <typename Frame>
+int LoopbackTransport::read_frames(Frame* frames, size_t count, bool want_fd) {
+    // Error frames go to the monitor once the queue is unlocked, so its
+    // callback may inject() again
+    constexpr size_t kMaxErrorFrames = 16;
+    can_frame error_frames[kMaxErrorFrames];
+    size_t read_count = 0;
+    // Like CANSocket, return 0 only once nothing readable is left, even if a
+    // full batch of error frames came first
+    bool more = true;
+    while (read_count == 0 && more && count > 0) {
+        size_t error_count = 0;
+        {
+            std::lock_guard<std::mutex> lock(rx_mutex_);
+            while (read_count < count && error_count < kMaxErrorFrames && !rx_queue_.empty()) {
+                const Entry& entry = rx_queue_.front();
+                if (!entry.is_fd && (entry.frame.can_id & CAN_ERR_FLAG)) {
+                    std::memcpy(&error_frames[error_count++], &entry.frame, sizeof(can_frame));
+                } else if (want_fd || !entry.is_fd) {
+                    // A classic socket never sees CAN FD frames
+                    std::memcpy(&frames[read_count], &entry.frame, sizeof(Frame));
+                    ++read_count;
+                }
+                rx_queue_.pop_front();
+            }
+            if (rx_queue_.empty()) {
+                uint64_t value;
+                (void)!read(event_fd_, &value, sizeof(value));
+                more = false;
+            }
+        }
+        for (size_t i = 0; i < error_count; ++i) error_monitor_.process(error_frames[i]);
+    }
+    return static_cast<int>(read_count);
+}
+
+}  // namespace openarm::canbus
@@ -0,0 +1,181 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <openarm/canbus/metrics.hpp>
+#include <sstream>
+#include <stdexcept>
+
+namespace openarm::canbus {
+
+namespace {
+std::string escape_label_value(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '"') {
+            escaped += "\\\"";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string escape_help(const std::string& help) {
+    std::string escaped;
+    escaped.reserve(help.size());
+    for (char c : help) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string render_labels(const MetricLabels& labels) {
+    if (labels.empty()) return "";
+    std::string rendered = "{";
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (i > 0) rendered += ",";
+        rendered += labels[i].first + "=\"" + escape_label_value(labels[i].second) + "\"";
+    }
+    return rendered + "}";
+}
+
+std::string format_gauge(double value) {
+    if (std::isnan(value)) return "NaN";
+    if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+    std::ostringstream out;
+    out.precision(17);
+    out << value;
+    return out.str();
+}
+}  // namespace
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+template <typename Metric>
+Metric& MetricsRegistry::get_or_create(const std::string& name, const std::string& help,
+                                       const MetricLabels& labels, bool is_counter,
+                                       std::deque<Metric>& store) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [family_it, inserted] = families_.try_emplace(name);
+    Family& family = family_it->second;
+    if (inserted) {
+        family.help = help;
+        family.is_counter = is_counter;
+    } else if (family.is_counter != is_counter) {
+        throw std::invalid_argument("Metric " + name + " is already registered as a " +
+                                    (family.is_counter ? "counter" : "gauge"));
+    }
+
+    std::string key = render_labels(labels);
+    auto series_it = family.series.find(key);
+    if (series_it != family.series.end()) {
+        return *static_cast<Metric*>(series_it->second);
+    }
+    Metric& metric = store.emplace_back();
+    family.series.emplace(key, &metric);
+    return metric;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                  const MetricLabels& labels) {
+    return get_or_create(name, help, labels, true, counters_);
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                              const MetricLabels& labels) {
+    return get_or_create(name, help, labels, false, gauges_);
+}
+
+std::string MetricsRegistry::render() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string text;
+    for (const auto& [name, family] : families_) {
+        text += "# HELP " + name + " " + escape_help(family.help) + "\n";
+        text += "# TYPE " + name + (family.is_counter ? " counter\n" : " gauge\n");
+        for (const auto& [labels, metric] : family.series) {
+            std::string value =
+                family.is_counter ? std::to_string(static_cast<const Counter*>(metric)->value())
+                                  : format_gauge(static_cast<const Gauge*>(metric)->value());
+            text += name + labels + " " + value + "\n";
+        }
+    }
+    return text;
+}
+
+bool MetricsRegistry::write_textfile(const std::string& path) const {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        if (!out) return false;
+        out << render();
+        out.close();
+        if (!out) {
+            remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+MetricsTextfileWriter::MetricsTextfileWriter(MetricsRegistry& registry, const std::string& path,
+                                             int interval_ms)
+    : registry_(registry), path_(path), interval_ms_(interval_ms) {
+    thread_ = std::thread(&MetricsTextfileWriter::run, this);
+}
+
+MetricsTextfileWriter::~MetricsTextfileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.join();
+    if (!registry_.write_textfile(path_)) ++write_failures_;
+}
+
+void MetricsTextfileWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        lock.unlock();
+        if (!registry_.write_textfile(path_)) ++write_failures_;
+        lock.lock();
+        wakeup_.wait_for(lock, std::chrono::milliseconds(interval_ms_),
+                         [this] { return stopping_; });
+    }
+}
+
+}  // namespace openarm::canbus
@@ -0,0 +1,160 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <openarm/canbus/trace.hpp>
+#include <stdexcept>
+
+namespace openarm::canbus {
+
+namespace {
+uint32_t current_tid() noexcept {
+    thread_local uint32_t tid = static_cast<uint32_t>(syscall(SYS_gettid));
+    return tid;
+}
+
+// Recorder of the scopes open on this thread. Nested scopes all report to
+// the outermost one's recorder, so one pointer and a depth describe them.
+thread_local TraceRecorder* scope_recorder = nullptr;
+thread_local uint32_t scope_depth = 0;
+}  // namespace
+
+std::atomic<TraceRecorder*> TraceRecorder::active_{nullptr};
+std::atomic<uint32_t> TraceRecorder::scope_users_{0};
+
+int64_t TraceRecorder::now_ns() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+TraceRecorder::TraceRecorder(const std::string& path, size_t ring_capacity,
+                             int drain_interval_ms)
+    : file_(fopen(path.c_str(), "w")),
+      drain_interval_ms_(drain_interval_ms),
+      queue_(ring_capacity) {
+    if (!file_) throw std::runtime_error("Failed to open trace file: " + path);
+    fprintf(file_, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    thread_ = std::thread(&TraceRecorder::run, this);
+}
+
+TraceRecorder::~TraceRecorder() {
+    // Stop routing scopes here before the queue goes away
+    TraceRecorder* self = this;
+    active_.compare_exchange_strong(self, nullptr);
+    // Scopes open on this thread cannot close while we wait; detach them
+    uint32_t own_scopes = scope_depth;
+    if (scope_recorder == this) scope_recorder = nullptr;
+    while (scope_users_.load() > own_scopes) std::this_thread::yield();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.join();
+    fprintf(file_, "\n]}\n");
+    fclose(file_);
+}
+
+void TraceRecorder::record(const char* category, const char* name, int64_t start_ns,
+                           int64_t duration_ns) noexcept {
+    uint32_t tid = current_tid();
+    bool queued = queue_.try_push([&](Event& event) {
+        event.category = category;
+        event.name = name;
+        event.start_ns = start_ns;
+        event.duration_ns = duration_ns;
+        event.tid = tid;
+    });
+    if (!queued) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    recorded_.fetch_add(1, std::memory_order_release);
+}
+
+size_t TraceRecorder::drain() {
+    size_t count = 0;
+    while (queue_.try_pop([this](const Event& event) {
+        // Timestamps are microseconds; keep nanosecond resolution
+        fprintf(file_,
+                "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld.%03lld,"
+                "\"dur\":%lld.%03lld,\"pid\":%d,\"tid\":%u}",
+                first_event_ ? "" : ",\n", event.name, event.category,
+                static_cast<long long>(event.start_ns / 1000),
+                static_cast<long long>(event.start_ns % 1000),
+                static_cast<long long>(event.duration_ns / 1000),
+                static_cast<long long>(event.duration_ns % 1000), static_cast<int>(getpid()),
+                event.tid);
+        first_event_ = false;
+    })) {
+        ++count;
+    }
+    return count;
+}
+
+void TraceRecorder::flush() {
+    uint64_t target = recorded_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex_);
+    flush_requested_ = true;
+    wakeup_.notify_one();
+    drained_.wait(lock, [this, target] { return written_ >= target || stopping_; });
+}
+
+void TraceRecorder::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        lock.unlock();
+        size_t count = drain();
+        lock.lock();
+        written_ += count;
+        if (count > 0 || flush_requested_) {
+            fflush(file_);
+            flush_requested_ = false;
+            drained_.notify_all();
+        }
+        if (stopping_ && written_ >= recorded_.load(std::memory_order_acquire)) break;
+        wakeup_.wait_for(lock, std::chrono::milliseconds(drain_interval_ms_));
+    }
+}
+
+void TraceScope::open() noexcept {
+    // Counted before loading the recorder, so ~TraceRecorder either waits
+    // for this scope or has already deactivated the recorder
+    TraceRecorder::scope_users_.fetch_add(1);
+    TraceRecorder* recorder = TraceRecorder::active_.load();
+    if (!recorder || (scope_depth > 0 && scope_recorder != recorder)) {
+        TraceRecorder::scope_users_.fetch_sub(1);
+        return;
+    }
+    scope_recorder = recorder;
+    ++scope_depth;
+    recorder_ = recorder;
+    start_ns_ = TraceRecorder::now_ns();
+}
+
+void TraceScope::close() noexcept {
+    // A recorder destroyed on this thread detached its scopes
+    if (scope_recorder == recorder_) {
+        recorder_->record(category_, name_, start_ns_, TraceRecorder::now_ns() - start_ns_);
+    }
+    TraceRecorder::scope_users_.fetch_sub(1);
+    if (--scope_depth == 0) scope_recorder = nullptr;
+}
+
+}  // namespace openarm::canbus
@@ -25,6 +25,7 @@ Motor::Motor(MotorType motor_type, uint32_t send_can_id, uint32_t recv_can_id)
       recv_can_id_(recv_can_id),
       motor_type_(motor_type),
       enabled_(false),
+      status_(MotorStatus::DISABLED),
       state_q_(0.0),
       state_dq_(0.0),
       state_tau_(0.0),
@@ -34,6 +35,9 @@ Motor::Motor(MotorType motor_type, uint32_t send_can_id, uint32_t recv_can_id)
 // Enable methods
 void Motor::set_enabled(bool enable) { this->enabled_ = enable; }
 
+// Reported by the motor; is_enabled() stays what the host commanded
+void Motor::set_status(MotorStatus status) { status_ = status; }
+
 // Parameter methods
 // TODO: storing temp params in motor object might not be a good idea
 // also -1 is not a good default value, consider using a different value
@@ -15,7 +15,7 @@
 #include <array>
 #include <cmath>
 #include <cstring>
-#include <iostream>
+#include <openarm/canbus/log.hpp>
 #include <openarm/damiao_motor/dm_motor.hpp>
 #include <openarm/damiao_motor/dm_motor_constants.hpp>
 #include <openarm/damiao_motor/dm_motor_control.hpp>
@@ -35,6 +35,10 @@ CANPacket CanPacketEncoder::create_set_zero_command(const Motor& motor) {
     return {motor.get_send_can_id(), pack_command_data(0xFE)};
 }
 
+CANPacket CanPacketEncoder::create_clear_error_command(const Motor& motor) {
+    return {motor.get_send_can_id(), pack_command_data(0xFB)};
+}
+
 CANPacket CanPacketEncoder::create_mit_control_command(const Motor& motor,
                                                        const MITParam& mit_param) {
     return {motor.get_send_can_id(), pack_mit_control_data(motor.get_motor_type(), mit_param)};
@@ -89,11 +93,16 @@ CANPacket CanPacketEncoder::create_refresh_command(const Motor& motor) {
 StateResult CanPacketDecoder::parse_motor_state_data(const Motor& motor,
                                                      const std::vector<uint8_t>& data) {
     if (data.size() < 8) {
-        std::cerr << "Warning: Skipping motor state data less than 8 bytes" << std::endl;
-        return {0, 0, 0, 0, 0, false};
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING,
+                                     "Skipping motor 0x%02X state data less than 8 bytes",
+                                     motor.get_recv_can_id());
+        return {0, 0, 0, 0, 0, MotorStatus::DISABLED, false};
     }
 
     // Parse state data
+    // D[0]: ERR (upper nibble) | ID (lower nibble)
+    MotorStatus status = motor_status_from_nibble(data[0] >> 4);
     uint16_t q_uint = (static_cast<uint16_t>(data[1]) << 8) | data[2];
     uint16_t dq_uint =
         (static_cast<uint16_t>(data[3]) << 4) | (static_cast<uint16_t>(data[4]) >> 4);
@@ -107,7 +116,7 @@ StateResult CanPacketDecoder::parse_motor_state_data(const Motor& motor,
     double recv_dq = CanPacketDecoder::uint_to_double(dq_uint, -limits.vMax, limits.vMax, 12);
     double recv_tau = CanPacketDecoder::uint_to_double(tau_uint, -limits.tMax, limits.tMax, 12);
 
-    return {recv_q, recv_dq, recv_tau, t_mos, t_rotor, true};
+    return {recv_q, recv_dq, recv_tau, t_mos, t_rotor, status, true};
 }
 
 ParamResult CanPacketDecoder::parse_motor_param_data(const std::vector<uint8_t>& data) {
@@ -124,7 +133,8 @@ ParamResult CanPacketDecoder::parse_motor_param_data(const std::vector<uint8_t>&
         }
         return {RID, num, true};
     } else {
-        std::cerr << "WARNING: INVALID PARAM DATA" << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING, "Invalid param data");
         return {0, NAN, false};
     }
 }
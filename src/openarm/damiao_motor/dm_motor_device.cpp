@@ -13,7 +13,7 @@
 // limitations under the License.
 
 #include <cmath>
-#include <iostream>
+#include <openarm/canbus/log.hpp>
 #include <openarm/damiao_motor/dm_motor.hpp>
 #include <openarm/damiao_motor/dm_motor_constants.hpp>
 #include <openarm/damiao_motor/dm_motor_control.hpp>
@@ -25,7 +25,21 @@ DMCANDevice::DMCANDevice(Motor& motor, canid_t recv_can_mask, bool use_fd)
     : canbus::CANDevice(motor.get_send_can_id(), motor.get_recv_can_id(), recv_can_mask, use_fd),
       motor_(motor),
       callback_mode_(CallbackMode::STATE),
-      use_fd_(use_fd) {}
+      use_fd_(use_fd) {
+    build_constant_frames();
+}
+
+void DMCANDevice::build_constant_frames() {
+    auto build = [this](ConstantCommand command, const CANPacket& packet) {
+        size_t index = static_cast<size_t>(command);
+        constant_can_frames_[index] = create_can_frame(packet.send_can_id, packet.data);
+        constant_canfd_frames_[index] = create_canfd_frame(packet.send_can_id, packet.data);
+    };
+    build(ConstantCommand::ENABLE, CanPacketEncoder::create_enable_command(motor_));
+    build(ConstantCommand::DISABLE, CanPacketEncoder::create_disable_command(motor_));
+    build(ConstantCommand::REFRESH, CanPacketEncoder::create_refresh_command(motor_));
+    build(ConstantCommand::CLEAR_ERROR, CanPacketEncoder::create_clear_error_command(motor_));
+}
 
 std::vector<uint8_t> DMCANDevice::get_data_from_frame(const can_frame& frame) {
     return std::vector<uint8_t>(frame.data, frame.data + frame.can_dlc);
@@ -36,7 +50,10 @@ std::vector<uint8_t> DMCANDevice::get_data_from_frame(const canfd_frame& frame)
 }
 void DMCANDevice::callback(const can_frame& frame) {
     if (use_fd_) {
-        std::cerr << "WARNING: WRONG CALLBACK FUNCTION" << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING,
+                                     "Classic CAN frame for CAN-FD motor 0x%02X",
+                                     motor_.get_send_can_id());
         return;
     }
 
@@ -47,16 +64,21 @@ void DMCANDevice::callback(const can_frame& frame) {
             if (frame.can_dlc >= 8) {
                 // Convert frame data to vector and let Motor handle parsing
                 StateResult result = CanPacketDecoder::parse_motor_state_data(motor_, data);
-                if (frame.can_id == motor_.get_recv_can_id() && result.valid) {
-                    motor_.update_state(result.position, result.velocity, result.torque,
-                                        result.t_mos, result.t_rotor);
+                if (!result.valid) {
+                    record_decode_error();
+                } else if (frame.can_id == motor_.get_recv_can_id()) {
+                    apply_state_result(result);
                 }
+            } else {
+                record_decode_error();
             }
             break;
         case PARAM: {
             ParamResult result = CanPacketDecoder::parse_motor_param_data(data);
             if (result.valid) {
                 motor_.set_temp_param(result.rid, result.value);
+            } else {
+                record_decode_error();
             }
             break;
         }
@@ -69,12 +91,18 @@ void DMCANDevice::callback(const can_frame& frame) {
 
 void DMCANDevice::callback(const canfd_frame& frame) {
     if (not use_fd_) {
-        std::cerr << "WARNING: CANFD MODE NOT ENABLED" << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING,
+                                     "CAN-FD frame for motor 0x%02X without CAN-FD enabled",
+                                     motor_.get_send_can_id());
         return;
     }
 
     if (frame.can_id != motor_.get_recv_can_id()) {
-        std::cerr << "WARNING: CANFD FRAME ID DOES NOT MATCH MOTOR ID" << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING,
+                                     "CAN-FD frame ID 0x%02X does not match motor 0x%02X",
+                                     frame.can_id, motor_.get_recv_can_id());
         return;
     }
 
@@ -82,19 +110,32 @@ void DMCANDevice::callback(const canfd_frame& frame) {
     if (callback_mode_ == STATE) {
         StateResult result = CanPacketDecoder::parse_motor_state_data(motor_, data);
         if (result.valid) {
-            motor_.update_state(result.position, result.velocity, result.torque, result.t_mos,
-                                result.t_rotor);
+            apply_state_result(result);
+        } else {
+            record_decode_error();
         }
     } else if (callback_mode_ == PARAM) {
         ParamResult result = CanPacketDecoder::parse_motor_param_data(data);
         if (result.valid) {
             motor_.set_temp_param(result.rid, result.value);
+        } else {
+            record_decode_error();
         }
     } else if (callback_mode_ == IGNORE) {
         return;
     }
 }
 
+void DMCANDevice::apply_state_result(const StateResult& result) {
+    motor_.update_state(result.position, result.velocity, result.torque, result.t_mos,
+                        result.t_rotor);
+    MotorStatus previous_status = motor_.get_status();
+    motor_.set_status(result.status);
+    if (fault_callback_ && is_fault_status(result.status) && result.status != previous_status) {
+        fault_callback_(motor_, result.status);
+    }
+}
+
 can_frame DMCANDevice::create_can_frame(canid_t send_can_id, std::vector<uint8_t> data) {
     can_frame frame;
     std::memset(&frame, 0, sizeof(frame));
@@ -106,6 +147,7 @@ can_frame DMCANDevice::create_can_frame(canid_t send_can_id, std::vector<uint8_t
 
 canfd_frame DMCANDevice::create_canfd_frame(canid_t send_can_id, std::vector<uint8_t> data) {
     canfd_frame frame;
+    std::memset(&frame, 0, sizeof(frame));
     frame.can_id = send_can_id;
     frame.len = data.size();
     frame.flags = CANFD_BRS;
@@ -15,57 +15,60 @@
 #include <linux/can.h>
 #include <linux/can/raw.h>
 
-#include <iostream>
+#include <openarm/canbus/log.hpp>
+#include <openarm/canbus/trace.hpp>
 #include <openarm/damiao_motor/dm_motor_device_collection.hpp>
 
 namespace openarm::damiao_motor {
 
-DMDeviceCollection::DMDeviceCollection(canbus::CANSocket& can_socket)
-    : can_socket_(can_socket),
+DMDeviceCollection::DMDeviceCollection(canbus::CANTransport& transport)
+    : transport_(transport),
       can_packet_encoder_(std::make_unique<CanPacketEncoder>()),
       can_packet_decoder_(std::make_unique<CanPacketDecoder>()),
-      device_collection_(std::make_unique<canbus::CANDeviceCollection>(can_socket_)) {}
+      device_collection_(std::make_unique<canbus::CANDeviceCollection>(transport_)) {}
 
 void DMDeviceCollection::enable_all() {
     for (auto dm_device : get_dm_devices()) {
-        auto& motor = dm_device->get_motor();
-        CANPacket enable_packet = CanPacketEncoder::create_enable_command(motor);
-        send_command_to_device(dm_device, enable_packet);
+        send_constant_command_to_device(dm_device, ConstantCommand::ENABLE);
     }
 }
 
 void DMDeviceCollection::disable_all() {
     for (auto dm_device : get_dm_devices()) {
-        CANPacket disable_packet = CanPacketEncoder::create_disable_command(dm_device->get_motor());
-        send_command_to_device(dm_device, disable_packet);
+        send_constant_command_to_device(dm_device, ConstantCommand::DISABLE);
+    }
+}
+
+void DMDeviceCollection::clear_error_one(int i) {
+    send_constant_command_to_device(get_dm_devices().at(i), ConstantCommand::CLEAR_ERROR);
+}
+
+void DMDeviceCollection::clear_error_all() {
+    for (auto dm_device : get_dm_devices()) {
+        send_constant_command_to_device(dm_device, ConstantCommand::CLEAR_ERROR);
     }
 }
 
 void DMDeviceCollection::set_zero(int i) {
     auto dm_device = get_dm_devices().at(i);
     auto zero_packet = CanPacketEncoder::create_set_zero_command(dm_device->get_motor());
-    send_command_to_device(dm_device, zero_packet);
+    send_command_to_device(dm_device, zero_packet, canbus::TxPriority::CONFIG);
 }
 
 void DMDeviceCollection::set_zero_all() {
     for (auto dm_device : get_dm_devices()) {
         CANPacket zero_packet = CanPacketEncoder::create_set_zero_command(dm_device->get_motor());
-        send_command_to_device(dm_device, zero_packet);
+        send_command_to_device(dm_device, zero_packet, canbus::TxPriority::CONFIG);
     }
 }
 
 void DMDeviceCollection::refresh_one(int i) {
-    auto dm_device = get_dm_devices().at(i);
-    auto& motor = dm_device->get_motor();
-    CANPacket refresh_packet = CanPacketEncoder::create_refresh_command(motor);
-    send_command_to_device(dm_device, refresh_packet);
+    send_constant_command_to_device(get_dm_devices().at(i), ConstantCommand::REFRESH);
 }
 
 void DMDeviceCollection::refresh_all() {
     for (auto dm_device : get_dm_devices()) {
-        auto& motor = dm_device->get_motor();
-        CANPacket refresh_packet = CanPacketEncoder::create_refresh_command(motor);
-        send_command_to_device(dm_device, refresh_packet);
+        send_constant_command_to_device(dm_device, ConstantCommand::REFRESH);
     }
 }
 
@@ -75,17 +78,23 @@ void DMDeviceCollection::set_callback_mode_all(CallbackMode callback_mode) {
     }
 }
 
+void DMDeviceCollection::set_fault_callback_all(const FaultCallback& fault_callback) {
+    for (auto dm_device : get_dm_devices()) {
+        dm_device->set_fault_callback(fault_callback);
+    }
+}
+
 void DMDeviceCollection::query_param_one(int i, int RID) {
     CANPacket param_query =
         CanPacketEncoder::create_query_param_command(get_dm_devices()[i]->get_motor(), RID);
-    send_command_to_device(get_dm_devices()[i], param_query);
+    send_command_to_device(get_dm_devices()[i], param_query, canbus::TxPriority::DIAGNOSTICS);
 }
 
 void DMDeviceCollection::query_param_all(int RID) {
     for (auto dm_device : get_dm_devices()) {
         CANPacket param_query =
             CanPacketEncoder::create_query_param_command(dm_device->get_motor(), RID);
-        send_command_to_device(dm_device, param_query);
+        send_command_to_device(dm_device, param_query, canbus::TxPriority::DIAGNOSTICS);
     }
 }
 
@@ -93,7 +102,7 @@ void DMDeviceCollection::set_control_mode_one(int i, ControlMode mode) {
     auto dm_device = get_dm_devices()[i];
     dm_device->set_control_mode(mode);
     CANPacket cmd = CanPacketEncoder::create_set_control_mode_command(dm_device->get_motor(), mode);
-    send_command_to_device(dm_device, cmd);
+    send_command_to_device(dm_device, cmd, canbus::TxPriority::CONFIG);
 }
 
 void DMDeviceCollection::set_control_mode_all(ControlMode mode) {
@@ -103,28 +112,79 @@ void DMDeviceCollection::set_control_mode_all(ControlMode mode) {
 }
 
 void DMDeviceCollection::send_command_to_device(std::shared_ptr<DMCANDevice> dm_device,
-                                                const CANPacket& packet) {
-    if (can_socket_.is_canfd_enabled()) {
-        canfd_frame frame = dm_device->create_canfd_frame(packet.send_can_id, packet.data);
-        can_socket_.write_canfd_frame(frame);
+                                                const CANPacket& packet,
+                                                canbus::TxPriority priority) {
+    canbus::TraceScope trace("send", "send_command_to_device");
+    if (transport_.is_canfd_enabled()) {
+        write_frame(dm_device->create_canfd_frame(packet.send_can_id, packet.data), priority,
+                    dm_device);
+    } else {
+        write_frame(dm_device->create_can_frame(packet.send_can_id, packet.data), priority,
+                    dm_device);
+    }
+}
+
+void DMDeviceCollection::send_constant_command_to_device(
+    const std::shared_ptr<DMCANDevice>& dm_device, ConstantCommand command) {
+    // Enable/disable/clear-error change whether the motor drives, so they
+    // preempt everything else.
+    canbus::TxPriority priority = command == ConstantCommand::REFRESH
+                                      ? canbus::TxPriority::DIAGNOSTICS
+                                      : canbus::TxPriority::SAFETY;
+    // A disable must not be refused for room while older frames wait
+    canbus::TxKind kind =
+        command == ConstantCommand::DISABLE ? canbus::TxKind::STOP : canbus::TxKind::NORMAL;
+    if (transport_.is_canfd_enabled()) {
+        write_frame(dm_device->get_constant_canfd_frame(command), priority, dm_device, kind);
     } else {
-        can_frame frame = dm_device->create_can_frame(packet.send_can_id, packet.data);
-        can_socket_.write_can_frame(frame);
+        write_frame(dm_device->get_constant_can_frame(command), priority, dm_device, kind);
     }
 }
 
+void DMDeviceCollection::write_frame(const can_frame& frame, canbus::TxPriority priority,
+                                     const std::shared_ptr<DMCANDevice>& dm_device,
+                                     canbus::TxKind kind) {
+    canbus::CyclePhaseTimer timer(cycle_stats_, canbus::CyclePhase::TX);
+    if (tx_scheduler_) {
+        // The scheduler records the outcome once the frame leaves its queue
+        tx_scheduler_->submit(frame, priority, dm_device, kind);
+        return;
+    }
+    dm_device->record_tx(transport_.write_can_frame(frame));
+}
+
+void DMDeviceCollection::write_frame(const canfd_frame& frame, canbus::TxPriority priority,
+                                     const std::shared_ptr<DMCANDevice>& dm_device,
+                                     canbus::TxKind kind) {
+    canbus::CyclePhaseTimer timer(cycle_stats_, canbus::CyclePhase::TX);
+    if (tx_scheduler_) {
+        tx_scheduler_->submit(frame, priority, dm_device, kind);
+        return;
+    }
+    dm_device->record_tx(transport_.write_canfd_frame(frame));
+}
+
 void DMDeviceCollection::mit_control_one(int i, const MITParam& mit_param) {
     auto dm_device = get_dm_devices()[i];
     if (dm_device->get_control_mode() != ControlMode::MIT) {
-        std::cerr << "WARNING: MIT control rejected; motor not in MIT mode." << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING,
+                                     "MIT control rejected; motor 0x%02X not in MIT mode",
+                                     dm_device->get_send_can_id());
+        dm_device->record_rejected_command();
         return;
     }
-    CANPacket mit_cmd =
-        CanPacketEncoder::create_mit_control_command(dm_device->get_motor(), mit_param);
+    CANPacket mit_cmd;
+    {
+        canbus::TraceScope trace("send", "encode");
+        canbus::CyclePhaseTimer timer(cycle_stats_, canbus::CyclePhase::ENCODE);
+        mit_cmd = CanPacketEncoder::create_mit_control_command(dm_device->get_motor(), mit_param);
+    }
     send_command_to_device(dm_device, mit_cmd);
 }
 
 void DMDeviceCollection::mit_control_all(const std::vector<MITParam>& mit_params) {
+    canbus::TraceScope trace("send", "mit_control_all");
     for (size_t i = 0; i < mit_params.size(); i++) {
         mit_control_one(i, mit_params[i]);
     }
@@ -133,11 +193,20 @@ void DMDeviceCollection::mit_control_all(const std::vector<MITParam>& mit_params
 void DMDeviceCollection::posvel_control_one(int i, const PosVelParam& posvel_param) {
     auto dm_device = get_dm_devices()[i];
     if (dm_device->get_control_mode() != ControlMode::POS_VEL) {
-        std::cerr << "WARNING: posvel control rejected; motor not in POS_VEL mode." << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING,
+                                     "posvel control rejected; motor 0x%02X not in POS_VEL mode",
+                                     dm_device->get_send_can_id());
+        dm_device->record_rejected_command();
         return;
     }
-    CANPacket posvel_cmd =
-        CanPacketEncoder::create_posvel_control_command(dm_device->get_motor(), posvel_param);
+    CANPacket posvel_cmd;
+    {
+        canbus::TraceScope trace("send", "encode");
+        canbus::CyclePhaseTimer timer(cycle_stats_, canbus::CyclePhase::ENCODE);
+        posvel_cmd =
+            CanPacketEncoder::create_posvel_control_command(dm_device->get_motor(), posvel_param);
+    }
     send_command_to_device(dm_device, posvel_cmd);
 }
 
@@ -150,11 +219,19 @@ void DMDeviceCollection::posvel_control_all(const std::vector<PosVelParam>& posv
 void DMDeviceCollection::vel_control_one(int i, const VelParam& vel_param) {
     auto dm_device = get_dm_devices()[i];
     if (dm_device->get_control_mode() != ControlMode::VEL) {
-        std::cerr << "WARNING: vel control rejected; motor not in VEL mode." << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(throttle, canbus::LogLevel::WARNING,
+                                     "vel control rejected; motor 0x%02X not in VEL mode",
+                                     dm_device->get_send_can_id());
+        dm_device->record_rejected_command();
         return;
     }
-    CANPacket vel_cmd =
-        CanPacketEncoder::create_vel_control_command(dm_device->get_motor(), vel_param);
+    CANPacket vel_cmd;
+    {
+        canbus::TraceScope trace("send", "encode");
+        canbus::CyclePhaseTimer timer(cycle_stats_, canbus::CyclePhase::ENCODE);
+        vel_cmd = CanPacketEncoder::create_vel_control_command(dm_device->get_motor(), vel_param);
+    }
     send_command_to_device(dm_device, vel_cmd);
 }
 
@@ -167,12 +244,21 @@ void DMDeviceCollection::vel_control_all(const std::vector<VelParam>& vel_params
 void DMDeviceCollection::posforce_control_one(int i, const PosForceParam& posforce_param) {
     auto dm_device = get_dm_devices()[i];
     if (dm_device->get_control_mode() != ControlMode::POS_FORCE) {
-        std::cerr << "WARNING: posforce control rejected; motor not in POS_FORCE mode."
-                  << std::endl;
+        static canbus::LogThrottle throttle;
+        canbus::Logger::global().log(
+            throttle, canbus::LogLevel::WARNING,
+            "posforce control rejected; motor 0x%02X not in POS_FORCE mode",
+            dm_device->get_send_can_id());
+        dm_device->record_rejected_command();
         return;
     }
-    CANPacket posforce_cmd =
-        CanPacketEncoder::create_posforce_control_command(dm_device->get_motor(), posforce_param);
+    CANPacket posforce_cmd;
+    {
+        canbus::TraceScope trace("send", "encode");
+        canbus::CyclePhaseTimer timer(cycle_stats_, canbus::CyclePhase::ENCODE);
+        posforce_cmd = CanPacketEncoder::create_posforce_control_command(dm_device->get_motor(),
+                                                                         posforce_param);
+    }
     send_command_to_device(dm_device, posforce_cmd);
 }
 
@@ -192,6 +278,15 @@ std::vector<Motor> DMDeviceCollection::get_motors() const {
 
 Motor DMDeviceCollection::get_motor(int i) const { return get_dm_devices().at(i)->get_motor(); }
 
+const canbus::LatencyHistogram& DMDeviceCollection::get_rtt_histogram(int i) const {
+    // Devices are owned by device_collection_, so the reference stays valid
+    return get_dm_devices().at(i)->get_rtt_histogram();
+}
+
+void DMDeviceCollection::reset_rtt_histograms() {
+    for (const auto& dm_device : get_dm_devices()) dm_device->reset_rtt_histogram();
+}
+
 std::vector<std::shared_ptr<DMCANDevice>> DMDeviceCollection::get_dm_devices() const {
     std::vector<std::shared_ptr<DMCANDevice>> dm_devices;
     for (const auto& [id, device] : device_collection_->get_devices()) {
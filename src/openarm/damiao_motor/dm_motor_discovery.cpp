@@ -0,0 +1,159 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <openarm/damiao_motor/dm_motor_constants.hpp>
+#include <openarm/damiao_motor/dm_motor_discovery.hpp>
+
+namespace openarm::damiao_motor {
+
+namespace {
+constexpr size_t kBatchSize = 64;
+constexpr int kQueueFullWaitUs = 200;
+constexpr canid_t kRegisterCanId = 0x7FF;
+constexpr uint8_t kReadRegister = 0x33;
+
+int64_t now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// One round of discovery: queries for the silent IDs, replies into found
+class DiscoveryRound {
+public:
+    DiscoveryRound(canbus::CANTransport& transport, std::map<uint32_t, uint32_t>& found)
+        : transport_(transport), found_(found) {}
+
+    void run(const std::vector<uint32_t>& slave_ids, int window_us) {
+        std::vector<uint32_t> silent;
+        for (uint32_t slave_id : slave_ids) {
+            if (found_.count(slave_id) == 0) silent.push_back(slave_id);
+        }
+        if (silent.empty()) return;
+
+        int64_t deadline_ns = now_ns() + static_cast<int64_t>(window_us) * 1000;
+        // The TX queue of a CAN interface is short; drain replies while it
+        // empties instead of giving up on the remaining queries
+        size_t sent = 0;
+        while (sent < silent.size() && now_ns() < deadline_ns) {
+            sent += write_queries(silent.data() + sent, silent.size() - sent);
+            if (sent < silent.size() && transport_.is_data_available(kQueueFullWaitUs)) {
+                read_replies();
+            }
+        }
+        // The window starts again after the last query left
+        deadline_ns = std::max(deadline_ns, now_ns() + static_cast<int64_t>(window_us) * 1000);
+        while (!all_found(silent)) {
+            int64_t remaining_us = (deadline_ns - now_ns()) / 1000;
+            if (remaining_us <= 0) break;
+            if (transport_.is_data_available(static_cast<int>(remaining_us))) read_replies();
+        }
+    }
+
+private:
+    size_t write_queries(const uint32_t* slave_ids, size_t count) {
+        count = std::min(count, kBatchSize);
+        int written;
+        if (transport_.is_canfd_enabled()) {
+            canfd_frame frames[kBatchSize];
+            for (size_t i = 0; i < count; ++i) {
+                std::memset(&frames[i], 0, sizeof(frames[i]));
+                frames[i].can_id = kRegisterCanId;
+                frames[i].len = 8;
+                frames[i].flags = CANFD_BRS;
+                fill_query(frames[i].data, slave_ids[i]);
+            }
+            written = transport_.write_canfd_frames(frames, count);
+        } else {
+            can_frame frames[kBatchSize];
+            for (size_t i = 0; i < count; ++i) {
+                std::memset(&frames[i], 0, sizeof(frames[i]));
+                frames[i].can_id = kRegisterCanId;
+                frames[i].can_dlc = 8;
+                fill_query(frames[i].data, slave_ids[i]);
+            }
+            written = transport_.write_can_frames(frames, count);
+        }
+        return written > 0 ? static_cast<size_t>(written) : 0;
+    }
+
+    // Same payload as CanPacketEncoder::create_query_param_command(), built in
+    // place: CAN_ID_L CAN_ID_H 0x33 RID, zero padded
+    static void fill_query(uint8_t* data, uint32_t slave_id) {
+        data[0] = static_cast<uint8_t>(slave_id & 0xFF);
+        data[1] = static_cast<uint8_t>((slave_id >> 8) & 0xFF);
+        data[2] = kReadRegister;
+        data[3] = static_cast<uint8_t>(RID::MST_ID);
+    }
+
+    void read_replies() {
+        if (transport_.is_canfd_enabled()) {
+            canfd_frame frames[kBatchSize];
+            int count = transport_.read_canfd_frames(frames, kBatchSize);
+            for (int i = 0; i < count; ++i) {
+                handle_reply(frames[i].can_id, frames[i].data, frames[i].len);
+            }
+        } else {
+            can_frame frames[kBatchSize];
+            int count = transport_.read_can_frames(frames, kBatchSize);
+            for (int i = 0; i < count; ++i) {
+                handle_reply(frames[i].can_id, frames[i].data, frames[i].can_dlc);
+            }
+        }
+    }
+
+    // Register replies echo the slave ID and RID: CAN_ID_L CAN_ID_H 0x33 RID.
+    // Queries look the same, so skip another host's on the register ID.
+    void handle_reply(canid_t can_id, const uint8_t* data, uint8_t len) {
+        if ((can_id & CAN_EFF_MASK) == kRegisterCanId) return;
+        if (len < 8 || data[2] != kReadRegister || data[3] != static_cast<uint8_t>(RID::MST_ID)) {
+            return;
+        }
+        uint32_t slave_id = data[0] | (static_cast<uint32_t>(data[1]) << 8);
+        found_.emplace(slave_id, can_id & CAN_EFF_MASK);
+    }
+
+    bool all_found(const std::vector<uint32_t>& slave_ids) const {
+        return std::all_of(slave_ids.begin(), slave_ids.end(),
+                           [this](uint32_t slave_id) { return found_.count(slave_id) > 0; });
+    }
+
+    canbus::CANTransport& transport_;
+    std::map<uint32_t, uint32_t>& found_;
+};
+}  // namespace
+
+std::vector<DiscoveredMotorID> discover_motors(canbus::CANTransport& transport,
+                                               const std::vector<uint32_t>& slave_ids,
+                                               const DiscoveryOptions& options) {
+    std::map<uint32_t, uint32_t> found;
+    DiscoveryRound round(transport, found);
+    for (int attempt = 0; attempt <= options.retries; ++attempt) {
+        round.run(slave_ids, options.window_us);
+    }
+
+    std::vector<DiscoveredMotorID> motors;
+    for (uint32_t slave_id : slave_ids) {
+        auto it = found.find(slave_id);
+        if (it != found.end()) motors.push_back({slave_id, it->second});
+    }
+    return motors;
+}
+
+}  // namespace openarm::damiao_motor
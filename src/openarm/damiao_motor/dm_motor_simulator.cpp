@@ -0,0 +1,456 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <openarm/damiao_motor/dm_motor_simulator.hpp>
+
+namespace openarm::damiao_motor {
+
+namespace {
+
+int64_t monotonic_now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+uint16_t double_to_uint(double x, double x_min, double x_max, int bits) {
+    x = std::max(x_min, std::min(x, x_max));
+    return static_cast<uint16_t>((x - x_min) / (x_max - x_min) * ((1 << bits) - 1));
+}
+
+double uint_to_double(uint16_t x, double x_min, double x_max, int bits) {
+    return static_cast<double>(x) / ((1 << bits) - 1) * (x_max - x_min) + x_min;
+}
+
+float bytes_to_float(const uint8_t* bytes) {
+    float value;
+    std::memcpy(&value, bytes, sizeof(float));
+    return value;
+}
+
+// Same register split as CanPacketDecoder::is_in_ranges: IDs, mode, versions
+// and baud are integers, everything else is a float.
+bool is_integer_register(int rid) {
+    return (7 <= rid && rid <= 10) || (13 <= rid && rid <= 16) || (35 <= rid && rid <= 36);
+}
+
+// Gains of the internal loops used outside MIT mode. The velocity loop gain is
+// scaled by inertia so its bandwidth does not depend on the joint.
+constexpr double kPositionLoopGain = 20.0;      // 1/s
+constexpr double kVelocityLoopBandwidth = 200.0;  // rad/s
+
+bool is_command_frame(const canfd_frame& frame) {
+    if (frame.len < 8) return false;
+    for (int i = 0; i < 7; ++i) {
+        if (frame.data[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+DMMotorSimulator::DMMotorSimulator(canbus::CANTransport& transport) : transport_(transport) {}
+
+DMMotorSimulator::~DMMotorSimulator() { stop(); }
+
+void DMMotorSimulator::add_motor(MotorType motor_type, uint32_t slave_id, uint32_t master_id,
+                                 double inertia, double damping) {
+    SimulatedMotor motor;
+    motor.motor_type = motor_type;
+    motor.slave_id = slave_id;
+    motor.master_id = master_id;
+
+    LimitParam limits = MOTOR_LIMIT_PARAMS[static_cast<int>(motor_type)];
+    motor.params[static_cast<int>(RID::MST_ID)] = master_id;
+    motor.params[static_cast<int>(RID::ESC_ID)] = slave_id;
+    motor.params[static_cast<int>(RID::CTRL_MODE)] = static_cast<int>(ControlMode::MIT);
+    motor.params[static_cast<int>(RID::Damp)] = damping;
+    motor.params[static_cast<int>(RID::Inertia)] = inertia;
+    motor.params[static_cast<int>(RID::PMAX)] = limits.pMax;
+    motor.params[static_cast<int>(RID::VMAX)] = limits.vMax;
+    motor.params[static_cast<int>(RID::TMAX)] = limits.tMax;
+    motor.params[static_cast<int>(RID::can_br)] = 4;  // 1 Mbps
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    motors_.push_back(motor);
+}
+
+void DMMotorSimulator::set_physics_rate_hz(double physics_rate_hz) {
+    if (physics_rate_hz <= 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    step_period_ns_ = static_cast<int64_t>(1e9 / physics_rate_hz);
+}
+
+void DMMotorSimulator::inject_fault(uint32_t slave_id, MotorStatus status) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto* motor = find_motor(slave_id)) motor->status = status;
+}
+
+SimulatedMotor DMMotorSimulator::get_motor(uint32_t slave_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& motor : motors_) {
+        if (motor.slave_id == slave_id) return motor;
+    }
+    return {};
+}
+
+SimulatedMotor* DMMotorSimulator::find_motor(uint32_t slave_id) {
+    for (auto& motor : motors_) {
+        if (motor.slave_id == slave_id) return &motor;
+    }
+    return nullptr;
+}
+
+void DMMotorSimulator::handle_frame(const canfd_frame& frame, bool is_fd) {
+    frames_received_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Replies report the state at the time the command arrives
+    advance_to(monotonic_now_ns());
+
+    if (frame.can_id == 0x7FF) {
+        handle_register_frame(frame, is_fd);
+        return;
+    }
+
+    // Control IDs are the slave ID plus a per-mode offset
+    uint32_t offset = frame.can_id & 0x700;
+    if (offset > 0x300) return;
+    SimulatedMotor* motor = find_motor(frame.can_id - offset);
+    if (motor) handle_command(*motor, frame, is_fd);
+}
+
+void DMMotorSimulator::handle_command(SimulatedMotor& motor, const canfd_frame& frame,
+                                      bool is_fd) {
+    if (is_command_frame(frame)) {
+        switch (frame.data[7]) {
+            case 0xFC:
+                if (!is_fault_status(motor.status)) motor.status = MotorStatus::ENABLED;
+                break;
+            case 0xFD:
+                if (!is_fault_status(motor.status)) motor.status = MotorStatus::DISABLED;
+                break;
+            case 0xFE:
+                motor.position = 0.0;
+                break;
+            case 0xFB:
+                motor.status = MotorStatus::DISABLED;
+                break;
+            default:
+                return;
+        }
+        queue_state_reply(motor, is_fd);
+        return;
+    }
+
+    // A real motor only listens on the control ID of its configured mode
+    ControlMode mode = static_cast<ControlMode>((frame.can_id >> 8) + 1);
+    if (mode != motor.control_mode) return;
+
+    LimitParam limits = MOTOR_LIMIT_PARAMS[static_cast<int>(motor.motor_type)];
+    const uint8_t* d = frame.data;
+    switch (mode) {
+        case ControlMode::MIT: {
+            if (frame.len < 8) return;
+            uint16_t q_uint = (static_cast<uint16_t>(d[0]) << 8) | d[1];
+            uint16_t dq_uint = (static_cast<uint16_t>(d[2]) << 4) | (d[3] >> 4);
+            uint16_t kp_uint = (static_cast<uint16_t>(d[3] & 0xF) << 8) | d[4];
+            uint16_t kd_uint = (static_cast<uint16_t>(d[5]) << 4) | (d[6] >> 4);
+            uint16_t tau_uint = (static_cast<uint16_t>(d[6] & 0xF) << 8) | d[7];
+            motor.q_des = uint_to_double(q_uint, -limits.pMax, limits.pMax, 16);
+            motor.dq_des = uint_to_double(dq_uint, -limits.vMax, limits.vMax, 12);
+            motor.kp = uint_to_double(kp_uint, 0, 500, 12);
+            motor.kd = uint_to_double(kd_uint, 0, 5, 12);
+            motor.tau_ff = uint_to_double(tau_uint, -limits.tMax, limits.tMax, 12);
+            break;
+        }
+        case ControlMode::POS_VEL:
+            if (frame.len < 8) return;
+            motor.q_des = bytes_to_float(d);
+            motor.dq_des = bytes_to_float(d + 4);
+            break;
+        case ControlMode::VEL:
+            if (frame.len < 4) return;
+            motor.dq_des = bytes_to_float(d);
+            break;
+        case ControlMode::POS_FORCE:
+            if (frame.len < 8) return;
+            motor.q_des = bytes_to_float(d);
+            motor.dq_des = (d[4] | (static_cast<uint16_t>(d[5]) << 8)) / 100.0;
+            motor.current_limit = (d[6] | (static_cast<uint16_t>(d[7]) << 8)) / 10000.0;
+            break;
+    }
+    queue_state_reply(motor, is_fd);
+}
+
+void DMMotorSimulator::handle_register_frame(const canfd_frame& frame, bool is_fd) {
+    if (frame.len < 8) return;
+    const uint8_t* d = frame.data;
+    SimulatedMotor* motor = find_motor(d[0] | (static_cast<uint32_t>(d[1]) << 8));
+    if (!motor) return;
+
+    uint8_t command = d[2];
+    uint8_t rid = d[3];
+    switch (command) {
+        case 0xCC:  // refresh
+            queue_state_reply(*motor, is_fd);
+            break;
+        case 0x33:  // read register
+            queue_register_reply(*motor, command, rid, is_fd);
+            break;
+        case 0x55: {  // write register
+            double value;
+            if (is_integer_register(rid)) {
+                uint32_t raw;
+                std::memcpy(&raw, d + 4, sizeof(raw));
+                value = raw;
+            } else {
+                value = bytes_to_float(d + 4);
+            }
+            motor->params[rid] = value;
+            if (rid == static_cast<int>(RID::CTRL_MODE)) {
+                motor->control_mode = static_cast<ControlMode>(static_cast<int>(value));
+            } else if (rid == static_cast<int>(RID::MST_ID)) {
+                motor->master_id = static_cast<uint32_t>(value);
+            }
+            queue_register_reply(*motor, command, rid, is_fd);
+            // ESC_ID takes effect after the reply, which still carries the old ID
+            if (rid == static_cast<int>(RID::ESC_ID)) {
+                motor->slave_id = static_cast<uint32_t>(value);
+            }
+            break;
+        }
+        case 0xAA: {  // save to flash
+            canfd_frame reply{};
+            reply.can_id = motor->master_id;
+            reply.len = 8;
+            reply.data[0] = d[0];
+            reply.data[1] = d[1];
+            reply.data[2] = 0xAA;
+            reply.data[3] = 0x01;
+            queue_reply(reply, is_fd);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void DMMotorSimulator::queue_state_reply(const SimulatedMotor& motor, bool is_fd) {
+    LimitParam limits = MOTOR_LIMIT_PARAMS[static_cast<int>(motor.motor_type)];
+    uint16_t q_uint = double_to_uint(motor.position, -limits.pMax, limits.pMax, 16);
+    uint16_t dq_uint = double_to_uint(motor.velocity, -limits.vMax, limits.vMax, 12);
+    uint16_t tau_uint = double_to_uint(motor.torque, -limits.tMax, limits.tMax, 12);
+
+    canfd_frame reply{};
+    reply.can_id = motor.master_id;
+    reply.len = 8;
+    // D[0]: ERR (upper nibble) | ID (lower nibble)
+    reply.data[0] = static_cast<uint8_t>((static_cast<uint8_t>(motor.status) << 4) |
+                                         (motor.slave_id & 0xF));
+    reply.data[1] = static_cast<uint8_t>(q_uint >> 8);
+    reply.data[2] = static_cast<uint8_t>(q_uint & 0xFF);
+    reply.data[3] = static_cast<uint8_t>(dq_uint >> 4);
+    reply.data[4] = static_cast<uint8_t>(((dq_uint & 0xF) << 4) | ((tau_uint >> 8) & 0xF));
+    reply.data[5] = static_cast<uint8_t>(tau_uint & 0xFF);
+    reply.data[6] = static_cast<uint8_t>(motor.t_mos);
+    reply.data[7] = static_cast<uint8_t>(motor.t_rotor);
+    queue_reply(reply, is_fd);
+}
+
+void DMMotorSimulator::queue_register_reply(const SimulatedMotor& motor, uint8_t command,
+                                            uint8_t rid, bool is_fd) {
+    auto it = motor.params.find(rid);
+    double value = it != motor.params.end() ? it->second : 0.0;
+
+    canfd_frame reply{};
+    reply.can_id = motor.master_id;
+    reply.len = 8;
+    reply.data[0] = static_cast<uint8_t>(motor.slave_id & 0xFF);
+    reply.data[1] = static_cast<uint8_t>((motor.slave_id >> 8) & 0xFF);
+    reply.data[2] = command;
+    reply.data[3] = rid;
+    if (is_integer_register(rid)) {
+        uint32_t raw = static_cast<uint32_t>(value);
+        std::memcpy(reply.data + 4, &raw, sizeof(raw));
+    } else {
+        float raw = static_cast<float>(value);
+        std::memcpy(reply.data + 4, &raw, sizeof(raw));
+    }
+    queue_reply(reply, is_fd);
+}
+
+void DMMotorSimulator::queue_reply(const canfd_frame& frame, bool is_fd) {
+    int latency_us = reply_latency_us_.load(std::memory_order_relaxed);
+    if (latency_us <= 0 && pending_replies_.empty()) {
+        write_frame(frame, is_fd);
+        return;
+    }
+    pending_replies_.push_back({monotonic_now_ns() + latency_us * 1000LL, frame, is_fd});
+}
+
+void DMMotorSimulator::send_due_replies(int64_t now_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Latency is constant, so the queue is already ordered by due time
+    while (!pending_replies_.empty() && pending_replies_.front().due_ns <= now_ns) {
+        write_frame(pending_replies_.front().frame, pending_replies_.front().is_fd);
+        pending_replies_.pop_front();
+    }
+}
+
+double DMMotorSimulator::compute_torque(const SimulatedMotor& motor) {
+    if (motor.status != MotorStatus::ENABLED) return 0.0;
+
+    LimitParam limits = MOTOR_LIMIT_PARAMS[static_cast<int>(motor.motor_type)];
+    double tau_max = limits.tMax;
+    double inertia = motor.params.at(static_cast<int>(RID::Inertia));
+    double velocity_gain = inertia * kVelocityLoopBandwidth;
+    double tau = 0.0;
+    switch (motor.control_mode) {
+        case ControlMode::MIT:
+            tau = motor.kp * (motor.q_des - motor.position) +
+                  motor.kd * (motor.dq_des - motor.velocity) + motor.tau_ff;
+            break;
+        case ControlMode::POS_VEL:
+        case ControlMode::POS_FORCE: {
+            // dq_des is the speed limit of the position loop
+            double speed_limit = std::abs(motor.dq_des);
+            double v_des = kPositionLoopGain * (motor.q_des - motor.position);
+            v_des = std::max(-speed_limit, std::min(v_des, speed_limit));
+            tau = velocity_gain * (v_des - motor.velocity);
+            if (motor.control_mode == ControlMode::POS_FORCE) {
+                tau_max *= std::max(0.0, std::min(motor.current_limit, 1.0));
+            }
+            break;
+        }
+        case ControlMode::VEL:
+            tau = velocity_gain * (motor.dq_des - motor.velocity);
+            break;
+    }
+    return std::max(-tau_max, std::min(tau, tau_max));
+}
+
+void DMMotorSimulator::step(double dt) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    step_locked(dt);
+}
+
+void DMMotorSimulator::step_locked(double dt) {
+    for (auto& motor : motors_) {
+        LimitParam limits = MOTOR_LIMIT_PARAMS[static_cast<int>(motor.motor_type)];
+        double inertia = motor.params[static_cast<int>(RID::Inertia)];
+        double damping = motor.params[static_cast<int>(RID::Damp)];
+        if (inertia <= 0) continue;
+
+        motor.torque = compute_torque(motor);
+        // Semi-implicit Euler: stable for the stiff MIT gains at 1 kHz
+        double acceleration = (motor.torque - damping * motor.velocity) / inertia;
+        motor.velocity =
+            std::max(-limits.vMax, std::min(motor.velocity + acceleration * dt, limits.vMax));
+        motor.position += motor.velocity * dt;
+        if (std::abs(motor.position) > limits.pMax) {
+            motor.position = std::max(-limits.pMax, std::min(motor.position, limits.pMax));
+            motor.velocity = 0.0;
+        }
+    }
+}
+
+void DMMotorSimulator::advance_to(int64_t now_ns) {
+    // Restart the clock after the first call or a long stall instead of
+    // replaying the whole gap
+    if (last_step_ns_ == 0 || now_ns - last_step_ns_ > 1000000000LL) {
+        last_step_ns_ = now_ns;
+        return;
+    }
+    double dt = step_period_ns_ * 1e-9;
+    while (now_ns - last_step_ns_ >= step_period_ns_) {
+        step_locked(dt);
+        last_step_ns_ += step_period_ns_;
+    }
+}
+
+void DMMotorSimulator::write_frame(const canfd_frame& frame, bool is_fd) {
+    bool written;
+    if (is_fd) {
+        written = transport_.write_canfd_frame(frame);
+    } else {
+        can_frame classic{};
+        classic.can_id = frame.can_id;
+        classic.can_dlc = std::min<uint8_t>(frame.len, CAN_MAX_DLEN);
+        std::memcpy(classic.data, frame.data, classic.can_dlc);
+        written = transport_.write_can_frame(classic);
+    }
+    if (written) frames_replied_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DMMotorSimulator::poll(int timeout_us) {
+    constexpr size_t kBatchSize = 32;
+
+    // Do not sleep past the next due reply or physics step
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timeout_us = static_cast<int>(std::min<int64_t>(timeout_us, step_period_ns_ / 1000));
+        if (!pending_replies_.empty()) {
+            int64_t wait_us = (pending_replies_.front().due_ns - monotonic_now_ns()) / 1000;
+            timeout_us =
+                static_cast<int>(std::max<int64_t>(0, std::min<int64_t>(timeout_us, wait_us)));
+        }
+    }
+
+    if (transport_.is_data_available(timeout_us)) {
+        if (transport_.is_canfd_enabled()) {
+            canfd_frame frames[kBatchSize];
+            int count;
+            while ((count = transport_.read_canfd_frames(frames, kBatchSize)) > 0) {
+                for (int i = 0; i < count; ++i) handle_frame(frames[i], true);
+            }
+        } else {
+            can_frame frames[kBatchSize];
+            int count;
+            while ((count = transport_.read_can_frames(frames, kBatchSize)) > 0) {
+                for (int i = 0; i < count; ++i) {
+                    canfd_frame frame{};
+                    frame.can_id = frames[i].can_id;
+                    frame.len = frames[i].can_dlc;
+                    std::memcpy(frame.data, frames[i].data, frames[i].can_dlc);
+                    handle_frame(frame, false);
+                }
+            }
+        }
+    }
+    int64_t now_ns = monotonic_now_ns();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        advance_to(now_ns);
+    }
+    send_due_replies(now_ns);
+}
+
+void DMMotorSimulator::start() {
+    if (running_.exchange(true)) return;
+    thread_ = std::thread([this] {
+        while (running_.load(std::memory_order_relaxed)) poll(1000);
+    });
+}
+
+void DMMotorSimulator::stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+}
+
+}  // namespace openarm::damiao_motor
@@ -0,0 +1,86 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <openarm/canbus/bus_load.hpp>
+#include <openarm/canbus/metrics.hpp>
+#include <thread>
+
+namespace {
+
+using openarm::canbus::BusLoadEstimator;
+using openarm::canbus::BusTiming;
+using openarm::canbus::frame_duration_ns;
+
+TEST(BusLoadTest, ClassicFrameWorstCaseBits) {
+    BusTiming timing;  // 1 Mbit/s, one bit per microsecond
+    can_frame frame{};
+    frame.can_id = 0x123;
+    frame.can_dlc = 8;
+    EXPECT_EQ(frame_duration_ns(frame, timing), 135000u);
+    frame.can_dlc = 0;
+    EXPECT_EQ(frame_duration_ns(frame, timing), 55000u);
+    frame.can_id = 0x123 | CAN_EFF_FLAG;
+    frame.can_dlc = 8;
+    EXPECT_EQ(frame_duration_ns(frame, timing), 160000u);
+    // Remote frames carry no data
+    frame.can_id = 0x123 | CAN_RTR_FLAG;
+    EXPECT_EQ(frame_duration_ns(frame, timing), 55000u);
+}
+
+TEST(BusLoadTest, FdFrameUsesDataBitrateWithBrs) {
+    BusTiming timing;
+    canfd_frame frame{};
+    frame.can_id = 0x123;
+    frame.len = 8;
+    uint64_t without_brs = frame_duration_ns(frame, timing);
+    frame.flags = CANFD_BRS;
+    uint64_t with_brs = frame_duration_ns(frame, timing);
+    EXPECT_LT(with_brs, without_brs);
+    // The nominal rate arbitration and trailer bound the saving
+    EXPECT_GT(with_brs, 30000u);
+
+    frame.len = 64;
+    uint64_t long_frame = frame_duration_ns(frame, timing);
+    EXPECT_GT(long_frame, with_brs);
+    timing.data_bitrate = 8000000;
+    EXPECT_LT(frame_duration_ns(frame, timing), long_frame);
+}
+
+TEST(BusLoadTest, EstimatesLoadPerInterval) {
+    openarm::canbus::Gauge gauge;
+    BusTiming timing;
+    // 10 ms intervals
+    BusLoadEstimator estimator(timing, &gauge, 10000000);
+    can_frame frames[10] = {};
+    for (auto& frame : frames) frame.can_dlc = 8;
+    // 10 x 135 us = 1.35 ms of bus time
+    estimator.record(frames, 10);
+    EXPECT_EQ(estimator.get_load(), 0.0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    estimator.update();
+    EXPECT_GT(estimator.get_load(), 0.0);
+    EXPECT_LE(estimator.get_load(), 0.135);
+    EXPECT_EQ(gauge.value(), estimator.get_load());
+
+    // An idle interval brings the load back to zero
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    estimator.update();
+    EXPECT_EQ(estimator.get_load(), 0.0);
+}
+
+}  // namespace
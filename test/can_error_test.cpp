@@ -0,0 +1,219 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <linux/can/error.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/can_error.hpp>
+#include <openarm/canbus/can_netlink.hpp>
+#include <openarm/canbus/fault_injection_transport.hpp>
+#include <openarm/canbus/log.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/canbus/metrics.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::CANBusState;
+using openarm::canbus::CANErrorClass;
+using openarm::canbus::CANErrorEvent;
+using openarm::canbus::CANErrorMonitor;
+
+can_frame error_frame(canid_t classes) {
+    can_frame frame{};
+    frame.can_id = CAN_ERR_FLAG | classes;
+    frame.can_dlc = CAN_ERR_DLC;
+    return frame;
+}
+
+TEST(CANErrorTest, DecodesControllerState) {
+    can_frame frame = error_frame(CAN_ERR_CRTL | CAN_ERR_CNT);
+    frame.data[1] = CAN_ERR_CRTL_TX_PASSIVE | CAN_ERR_CRTL_RX_OVERFLOW;
+    frame.data[6] = 130;
+    frame.data[7] = 5;
+    CANErrorEvent event = openarm::canbus::decode_error_frame(frame, CANBusState::ERROR_ACTIVE);
+    EXPECT_TRUE(event.has(CANErrorClass::CONTROLLER));
+    EXPECT_FALSE(event.has(CANErrorClass::BUS_OFF));
+    EXPECT_EQ(event.state, CANBusState::ERROR_PASSIVE);
+    EXPECT_TRUE(event.rx_overflow);
+    EXPECT_FALSE(event.tx_overflow);
+    EXPECT_TRUE(event.has_error_counters);
+    EXPECT_EQ(event.tx_error_counter, 130);
+    EXPECT_EQ(event.rx_error_counter, 5);
+
+    frame.data[1] = CAN_ERR_CRTL_RX_WARNING;
+    EXPECT_EQ(openarm::canbus::decode_error_frame(frame, CANBusState::ERROR_ACTIVE).state,
+              CANBusState::ERROR_WARNING);
+    frame.data[1] = CAN_ERR_CRTL_ACTIVE;
+    EXPECT_EQ(openarm::canbus::decode_error_frame(frame, CANBusState::ERROR_PASSIVE).state,
+              CANBusState::ERROR_ACTIVE);
+}
+
+TEST(CANErrorTest, BusOffAndRestart) {
+    CANErrorEvent event = openarm::canbus::decode_error_frame(error_frame(CAN_ERR_BUSOFF),
+                                                              CANBusState::ERROR_PASSIVE);
+    EXPECT_EQ(event.state, CANBusState::BUS_OFF);
+    event = openarm::canbus::decode_error_frame(error_frame(CAN_ERR_RESTARTED), event.state);
+    EXPECT_EQ(event.state, CANBusState::ERROR_ACTIVE);
+    // Classes without state information keep the previous state
+    event = openarm::canbus::decode_error_frame(error_frame(CAN_ERR_ACK), CANBusState::BUS_OFF);
+    EXPECT_TRUE(event.has(CANErrorClass::NO_ACK));
+    EXPECT_EQ(event.state, CANBusState::BUS_OFF);
+}
+
+TEST(CANErrorTest, MonitorCountsAndReports) {
+    openarm::canbus::MetricsRegistry registry;
+    CANErrorMonitor monitor;
+    std::vector<CANErrorEvent> events;
+    monitor.set_callback([&](const CANErrorEvent& event) { events.push_back(event); });
+
+    can_frame data_frame{};
+    data_frame.can_id = 0x11;
+    EXPECT_FALSE(monitor.process(data_frame));
+    EXPECT_TRUE(monitor.process(error_frame(CAN_ERR_ACK | CAN_ERR_PROT)));
+    monitor.bind_metrics(registry, {{"interface", "can0"}});
+    EXPECT_TRUE(monitor.process(error_frame(CAN_ERR_BUSOFF)));
+
+    EXPECT_EQ(events.size(), 2u);
+    EXPECT_EQ(monitor.get_error_frames(), 2u);
+    EXPECT_EQ(monitor.get_error_count(CANErrorClass::NO_ACK), 1u);
+    EXPECT_EQ(monitor.get_error_count(CANErrorClass::PROTOCOL), 1u);
+    EXPECT_EQ(monitor.get_error_count(CANErrorClass::BUS_OFF), 1u);
+    EXPECT_EQ(monitor.get_state(), CANBusState::BUS_OFF);
+
+    std::string text = registry.render();
+    EXPECT_NE(
+        text.find("openarm_can_bus_error_frames_total{interface=\"can0\",class=\"no_ack\"} 1"),
+        std::string::npos);
+    EXPECT_NE(text.find("openarm_can_bus_state{interface=\"can0\"} 3"), std::string::npos);
+}
+
+TEST(CANErrorTest, OpenArmReportsErrorFramesInsteadOfDispatching) {
+    auto transport = std::make_unique<openarm::canbus::LoopbackTransport>(true, "error_test");
+    auto* loopback = transport.get();
+    openarm::can::socket::OpenArm openarm(std::move(transport));
+    openarm.init_arm_motors({openarm::damiao_motor::MotorType::DM4310}, {0x01}, {0x11});
+
+    std::vector<CANErrorEvent> events;
+    openarm.set_bus_error_callback([&](const CANErrorEvent& event) { events.push_back(event); });
+    loopback->inject(error_frame(CAN_ERR_BUSOFF));
+    openarm.recv_all(0);
+
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_TRUE(events[0].has(CANErrorClass::BUS_OFF));
+    EXPECT_EQ(openarm.get_bus_state(), CANBusState::BUS_OFF);
+    EXPECT_EQ(openarm.get_master_can_device_collection().get_unknown_id_frames(), 0u);
+    // Recovery is off by default
+    EXPECT_EQ(openarm.get_bus_off_restarts(), 0u);
+}
+
+TEST(CANErrorTest, RecvAllDrainsRepliesBehindErrorFrames) {
+    auto transport = std::make_unique<openarm::canbus::LoopbackTransport>(false, "error_test");
+    auto* loopback = transport.get();
+    openarm::can::socket::OpenArm openarm(std::move(transport));
+    openarm.init_arm_motors({openarm::damiao_motor::MotorType::DM4310}, {0x01}, {0x11});
+
+    // More error frames than one read handles before returning
+    for (int i = 0; i < 40; ++i) loopback->inject(error_frame(CAN_ERR_CRTL));
+    can_frame reply{};
+    reply.can_id = 0x11;
+    reply.can_dlc = 8;
+    const uint8_t data[8] = {0x11, 0x80, 0x00, 0x80, 0x08, 0x00, 30, 35};
+    std::copy(data, data + 8, reply.data);
+    loopback->inject(reply);
+    openarm.recv_all(0);
+
+    EXPECT_EQ(openarm.get_arm().get_motors()[0].get_state_tmos(), 30);
+    EXPECT_EQ(loopback->rx_pending(), 0u);
+}
+
+TEST(CANErrorTest, BusOffIsLoggedForEveryInterface) {
+    std::vector<std::string> messages;
+    std::mutex messages_mutex;
+    auto& logger = openarm::canbus::Logger::global();
+    logger.set_sink([&](openarm::canbus::LogLevel, const char* message) {
+        std::lock_guard<std::mutex> lock(messages_mutex);
+        messages.emplace_back(message);
+    });
+    std::vector<std::unique_ptr<openarm::can::socket::OpenArm>> openarms;
+    std::vector<openarm::canbus::LoopbackTransport*> loopbacks;
+    for (const char* interface : {"can0_busoff", "can1_busoff"}) {
+        auto transport = std::make_unique<openarm::canbus::LoopbackTransport>(false, interface);
+        loopbacks.push_back(transport.get());
+        openarms.push_back(std::make_unique<openarm::can::socket::OpenArm>(std::move(transport)));
+    }
+    for (size_t i = 0; i < openarms.size(); ++i) {
+        loopbacks[i]->inject(error_frame(CAN_ERR_BUSOFF));
+        openarms[i]->recv_all(0);
+    }
+    logger.flush();
+    logger.set_sink(nullptr);
+
+    int reported = 0;
+    for (const auto& message : messages) {
+        if (message.find("bus-off on can0_busoff") != std::string::npos) ++reported;
+        if (message.find("bus-off on can1_busoff") != std::string::npos) ++reported;
+    }
+    EXPECT_EQ(reported, 2);
+}
+
+TEST(CANErrorTest, DecoratorForwardsErrorMonitor) {
+    openarm::canbus::LoopbackTransport inner(false, "error_test");
+    openarm::canbus::FaultInjectionTransport faulty(inner);
+    EXPECT_EQ(&faulty.get_error_monitor(), &inner.get_error_monitor());
+}
+
+TEST(CANErrorTest, RestartUnknownInterfaceFails) {
+    try {
+        openarm::canbus::restart_can_interface("openarm_none0");
+        FAIL() << "restart succeeded";
+    } catch (const openarm::canbus::CANNetlinkException& e) {
+        EXPECT_EQ(e.error_code(), ENODEV);
+    }
+}
+
+TEST(CANErrorTest, RestarterRunsInTheBackground) {
+    openarm::canbus::CANInterfaceRestarter restarter("openarm_none0");
+    EXPECT_TRUE(restarter.request_restart());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (restarter.get_failures() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(restarter.get_failures(), 1u);
+    EXPECT_EQ(restarter.get_restarts(), 0u);
+    // Nothing is pending any more, so a new request is accepted
+    EXPECT_TRUE(restarter.request_restart());
+}
+
+TEST(CANErrorTest, OpenArmRequestsRestartOutsideRecvAll) {
+    auto transport = std::make_unique<openarm::canbus::LoopbackTransport>(false, "openarm_none0");
+    auto* loopback = transport.get();
+    openarm::can::socket::OpenArm openarm(std::move(transport));
+    openarm.set_bus_off_recovery(openarm::can::socket::BusOffRecovery::RESTART);
+    loopback->inject(error_frame(CAN_ERR_BUSOFF));
+    openarm.recv_all(0);
+    EXPECT_EQ(openarm.get_bus_state(), CANBusState::BUS_OFF);
+    // The restart of the missing interface fails on the worker, not here
+    EXPECT_EQ(openarm.get_bus_off_restarts(), 0u);
+}
+
+}  // namespace
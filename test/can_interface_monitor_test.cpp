@@ -0,0 +1,75 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <openarm/canbus/can_interface_monitor.hpp>
+#include <openarm/canbus/can_netlink.hpp>
+#include <openarm/canbus/metrics.hpp>
+#include <string>
+
+namespace {
+
+using openarm::canbus::CANInterfaceMonitor;
+using openarm::canbus::CANInterfaceStatus;
+using openarm::canbus::MetricsRegistry;
+
+TEST(CANInterfaceMonitorTest, ReadsNonCANInterface) {
+    CANInterfaceStatus status = openarm::canbus::read_can_interface_status("lo");
+    EXPECT_TRUE(status.up);
+    EXPECT_FALSE(status.is_can);
+    EXPECT_EQ(status.state, openarm::canbus::CANBusState::STOPPED);
+    EXPECT_FALSE(status.has_error_counters);
+}
+
+TEST(CANInterfaceMonitorTest, UnknownInterfaceFails) {
+    try {
+        openarm::canbus::read_can_interface_status("openarm_none0");
+        FAIL() << "read succeeded";
+    } catch (const openarm::canbus::CANNetlinkException& e) {
+        EXPECT_EQ(e.error_code(), ENODEV);
+    }
+}
+
+TEST(CANInterfaceMonitorTest, ConfigureUnknownInterfaceFails) {
+    try {
+        openarm::canbus::configure_can_interface("openarm_none0", {});
+        FAIL() << "configure succeeded";
+    } catch (const openarm::canbus::CANNetlinkException& e) {
+        EXPECT_EQ(e.error_code(), ENODEV);
+    }
+}
+
+TEST(CANInterfaceMonitorTest, PublishesStatus) {
+    MetricsRegistry registry;
+    CANInterfaceMonitor monitor({"lo", "openarm_none0"}, registry, 10000);
+
+    CANInterfaceStatus status;
+    EXPECT_TRUE(monitor.get_status(0, status));
+    EXPECT_TRUE(status.up);
+    EXPECT_FALSE(monitor.get_status(1, status));
+    EXPECT_FALSE(monitor.get_status(2, status));
+    EXPECT_EQ(monitor.get_poll_failures(), 1u);
+
+    monitor.poll();
+    EXPECT_EQ(monitor.get_poll_failures(), 2u);
+
+    std::string text = registry.render();
+    EXPECT_NE(text.find("openarm_can_interface_state{interface=\"lo\"} 4"), std::string::npos);
+    EXPECT_NE(text.find("openarm_can_interface_bus_off_total{interface=\"lo\"} 0"),
+              std::string::npos);
+}
+
+}  // namespace
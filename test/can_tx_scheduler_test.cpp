@@ -0,0 +1,367 @@
+// Copyright 2026 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <openarm/canbus/can_tx_scheduler.hpp>
+#include <openarm/canbus/fault_injection_transport.hpp>
+#include <chrono>
+#include <memory>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::CANDevice;
+using openarm::canbus::CANTxScheduler;
+using openarm::canbus::FaultInjectionTransport;
+using openarm::canbus::FaultProfile;
+using openarm::canbus::LoopbackTransport;
+using openarm::canbus::TxKind;
+using openarm::canbus::TxOutcome;
+using openarm::canbus::TxPriority;
+using openarm::canbus::TxStopFrames;
+
+can_frame make_frame(canid_t can_id, uint8_t value = 0) {
+    can_frame frame{};
+    frame.can_id = can_id;
+    frame.can_dlc = 8;
+    for (int i = 0; i < 8; ++i) frame.data[i] = value;
+    return frame;
+}
+
+class CountingDevice : public CANDevice {
+public:
+    explicit CountingDevice(canid_t can_id) : CANDevice(can_id, can_id + 0x10, CAN_SFF_MASK) {}
+    void callback(const can_frame&) override {}
+    void callback(const canfd_frame&) override {}
+};
+
+class CANTxSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override { LoopbackTransport::connect(near_, far_); }
+
+    // Simulate a full socket TX queue
+    void set_refusing(bool refusing) {
+        FaultProfile profile;
+        profile.refuse_probability = refusing ? 1.0 : 0.0;
+        faulty_.set_tx_profile(profile);
+    }
+
+    std::vector<can_frame> read_all() {
+        std::vector<can_frame> frames;
+        can_frame frame;
+        while (far_.read_can_frame(frame)) frames.push_back(frame);
+        return frames;
+    }
+
+    LoopbackTransport near_;
+    LoopbackTransport far_;
+    FaultInjectionTransport faulty_{near_};
+};
+
+}  // namespace
+
+TEST_F(CANTxSchedulerTest, HigherClassesGoFirst) {
+    CANTxScheduler scheduler(faulty_);
+    set_refusing(true);
+    EXPECT_EQ(scheduler.submit(make_frame(0x03), TxPriority::CONFIG), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x02), TxPriority::CONTROL), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01), TxPriority::SAFETY), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.pending(), 3u);
+
+    set_refusing(false);
+    EXPECT_EQ(scheduler.flush(), 3u);
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0].can_id, 0x01u);
+    EXPECT_EQ(frames[1].can_id, 0x02u);
+    EXPECT_EQ(frames[2].can_id, 0x03u);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).sent, 1u);
+}
+
+TEST_F(CANTxSchedulerTest, BackpressureRetriesUpToTheLimit) {
+    CANTxScheduler scheduler(faulty_);
+    scheduler.set_retry_limit(TxPriority::CONTROL, 2);
+    set_refusing(true);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01), TxPriority::CONTROL), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.flush(), 0u);
+    EXPECT_EQ(scheduler.flush(), 0u);
+    EXPECT_EQ(scheduler.pending(TxPriority::CONTROL), 1u);
+    // The third refused flush exhausts the two retries
+    EXPECT_EQ(scheduler.flush(), 0u);
+    EXPECT_EQ(scheduler.pending(TxPriority::CONTROL), 0u);
+
+    const auto& stats = scheduler.get_stats(TxPriority::CONTROL);
+    EXPECT_EQ(stats.backpressure, 4u);
+    EXPECT_EQ(stats.dropped_backpressure, 1u);
+    EXPECT_EQ(stats.sent, 0u);
+    EXPECT_EQ(faulty_.get_tx_stats().refused, 4u);
+}
+
+TEST_F(CANTxSchedulerTest, SubmitBurstDoesNotUseUpRetries) {
+    CANTxScheduler scheduler(faulty_);
+    set_refusing(true);
+    // One mit_control_all() burst: every submit flushes and is refused
+    for (canid_t can_id = 0x01; can_id <= 0x08; ++can_id) {
+        EXPECT_EQ(scheduler.submit(make_frame(can_id), TxPriority::CONTROL), TxOutcome::QUEUED);
+    }
+    EXPECT_EQ(scheduler.pending(TxPriority::CONTROL), 8u);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::CONTROL).dropped_backpressure, 0u);
+
+    set_refusing(false);
+    EXPECT_EQ(scheduler.flush(), 8u);
+}
+
+TEST_F(CANTxSchedulerTest, RetriedFrameIsSentOncePressureClears) {
+    CANTxScheduler scheduler(faulty_);
+    set_refusing(true);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01), TxPriority::SAFETY), TxOutcome::QUEUED);
+    set_refusing(false);
+    EXPECT_EQ(scheduler.flush(), 1u);
+    EXPECT_EQ(read_all().size(), 1u);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).backpressure, 1u);
+}
+
+TEST_F(CANTxSchedulerTest, FullSafetyQueueRefusesInsteadOfEvicting) {
+    CANTxScheduler scheduler(faulty_, 2);
+    set_refusing(true);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01), TxPriority::SAFETY), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x02), TxPriority::SAFETY), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x03), TxPriority::SAFETY), TxOutcome::DROPPED);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).dropped_overflow, 1u);
+
+    set_refusing(false);
+    scheduler.flush();
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].can_id, 0x01u);
+    EXPECT_EQ(frames[1].can_id, 0x02u);
+}
+
+TEST_F(CANTxSchedulerTest, RepeatedSafetyCommandIsSentOnce) {
+    CANTxScheduler scheduler(faulty_);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01, 0xFC), TxPriority::SAFETY);
+    scheduler.submit(make_frame(0x02, 0xFC), TxPriority::SAFETY);
+    scheduler.submit(make_frame(0x01, 0xFC), TxPriority::SAFETY);
+    EXPECT_EQ(scheduler.pending(TxPriority::SAFETY), 2u);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).coalesced, 1u);
+
+    set_refusing(false);
+    scheduler.flush();
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].can_id, 0x01u);
+    EXPECT_EQ(frames[1].can_id, 0x02u);
+}
+
+TEST_F(CANTxSchedulerTest, EnableDoesNotReplaceQueuedClearError) {
+    CANTxScheduler scheduler(faulty_);
+    set_refusing(true);
+    // clear_error_all(); enable_all(); under backpressure
+    scheduler.submit(make_frame(0x01, 0xFB), TxPriority::SAFETY);
+    scheduler.submit(make_frame(0x01, 0xFC), TxPriority::SAFETY);
+    EXPECT_EQ(scheduler.pending(TxPriority::SAFETY), 2u);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).coalesced, 0u);
+
+    set_refusing(false);
+    scheduler.flush();
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].data[7], 0xFB);
+    EXPECT_EQ(frames[1].data[7], 0xFC);
+}
+
+TEST_F(CANTxSchedulerTest, NormalFrameNeverReplacesQueuedStop) {
+    CANTxScheduler scheduler(faulty_);
+    scheduler.set_retry_limit(TxPriority::CONTROL, 100);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01, 0xFD), TxPriority::CONTROL, nullptr, TxKind::STOP);
+    scheduler.submit(make_frame(0x01, 0xAA), TxPriority::CONTROL);
+    EXPECT_EQ(scheduler.pending(TxPriority::CONTROL), 2u);
+
+    set_refusing(false);
+    scheduler.flush();
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].data[7], 0xFD);
+    EXPECT_EQ(frames[1].data[7], 0xAA);
+}
+
+TEST_F(CANTxSchedulerTest, FullQueueEvictsTheOldestNonStopFrameForAStop) {
+    CANTxScheduler scheduler(faulty_, 2);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01, 0xFC), TxPriority::SAFETY);
+    scheduler.submit(make_frame(0x02, 0xFD), TxPriority::SAFETY, nullptr, TxKind::STOP);
+    EXPECT_EQ(scheduler.submit(make_frame(0x03, 0xFD), TxPriority::SAFETY, nullptr, TxKind::STOP),
+              TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).evicted, 1u);
+    // Only stop frames left, so the next one is refused
+    EXPECT_EQ(scheduler.submit(make_frame(0x04, 0xFD), TxPriority::SAFETY, nullptr, TxKind::STOP),
+              TxOutcome::DROPPED);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).dropped_overflow, 1u);
+
+    set_refusing(false);
+    scheduler.flush();
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].can_id, 0x02u);
+    EXPECT_EQ(frames[1].can_id, 0x03u);
+}
+
+TEST_F(CANTxSchedulerTest, ControlFramesCoalesceByCanId) {
+    CANTxScheduler scheduler(faulty_, 2);
+    scheduler.set_retry_limit(TxPriority::CONTROL, 100);
+    set_refusing(true);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01, 0xAA), TxPriority::CONTROL), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x02, 0xAA), TxPriority::CONTROL), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01, 0xBB), TxPriority::CONTROL), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.pending(TxPriority::CONTROL), 2u);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::CONTROL).coalesced, 1u);
+    // A third CAN ID does not fit and does not push out another motor's frame
+    EXPECT_EQ(scheduler.submit(make_frame(0x03), TxPriority::CONTROL), TxOutcome::DROPPED);
+
+    set_refusing(false);
+    scheduler.flush();
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].can_id, 0x01u);
+    EXPECT_EQ(frames[0].data[0], 0xBB);
+    EXPECT_EQ(frames[1].can_id, 0x02u);
+}
+
+TEST_F(CANTxSchedulerTest, ConfigFramesSharingACanIdAreAllSent) {
+    CANTxScheduler scheduler(faulty_);
+    set_refusing(true);
+    EXPECT_EQ(scheduler.submit(make_frame(0x7FF, 0x01), TxPriority::CONFIG), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x7FF, 0x02), TxPriority::CONFIG), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.pending(TxPriority::CONFIG), 2u);
+
+    set_refusing(false);
+    scheduler.flush();
+    EXPECT_EQ(read_all().size(), 2u);
+}
+
+TEST_F(CANTxSchedulerTest, SubmitReportsTheSubmittedFrameOnly) {
+    CANTxScheduler scheduler(faulty_);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01), TxPriority::SAFETY), TxOutcome::SENT);
+    read_all();
+
+    set_refusing(true);
+    // DIAGNOSTICS gives up on the first refusal
+    EXPECT_EQ(scheduler.submit(make_frame(0x7FF), TxPriority::DIAGNOSTICS), TxOutcome::DROPPED);
+    EXPECT_EQ(scheduler.submit(make_frame(0x01), TxPriority::SAFETY), TxOutcome::QUEUED);
+    scheduler.set_retry_limit(TxPriority::SAFETY, 0);
+    // The flush drops the queued safety frame, not the one just submitted
+    EXPECT_EQ(scheduler.submit(make_frame(0x02), TxPriority::CONTROL), TxOutcome::QUEUED);
+    EXPECT_EQ(scheduler.pending(TxPriority::SAFETY), 0u);
+}
+
+TEST_F(CANTxSchedulerTest, OwnerSeesTheOutcomeWhenTheFrameLeaves) {
+    CANTxScheduler scheduler(faulty_);
+    auto device = std::make_shared<CountingDevice>(0x01);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01), TxPriority::SAFETY, device);
+    EXPECT_EQ(device->get_tx_frames(), 0u);
+    EXPECT_EQ(device->get_tx_failures(), 0u);
+
+    set_refusing(false);
+    scheduler.flush();
+    EXPECT_EQ(device->get_tx_frames(), 1u);
+    EXPECT_EQ(device->get_tx_failures(), 0u);
+}
+
+TEST_F(CANTxSchedulerTest, DropsAreChargedToTheirOwner) {
+    CANTxScheduler scheduler(faulty_, 1);
+    scheduler.set_retry_limit(TxPriority::CONTROL, 100);
+    auto first = std::make_shared<CountingDevice>(0x01);
+    auto second = std::make_shared<CountingDevice>(0x02);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01, 0xAA), TxPriority::CONTROL, first);
+    // Coalesced away by a newer frame for the same CAN ID
+    scheduler.submit(make_frame(0x01, 0xBB), TxPriority::CONTROL, first);
+    EXPECT_EQ(first->get_tx_failures(), 1u);
+    // Refused by the full queue
+    scheduler.submit(make_frame(0x02), TxPriority::CONTROL, second);
+    EXPECT_EQ(second->get_tx_failures(), 1u);
+    EXPECT_EQ(first->get_tx_failures(), 1u);
+
+    set_refusing(false);
+    scheduler.flush();
+    EXPECT_EQ(first->get_tx_frames(), 1u);
+    EXPECT_EQ(second->get_tx_frames(), 0u);
+}
+
+TEST_F(CANTxSchedulerTest, RoundTripStartsWhenTheFrameIsWritten) {
+    CANTxScheduler scheduler(faulty_);
+    auto device = std::make_shared<CountingDevice>(0x01);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01), TxPriority::SAFETY, device);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    set_refusing(false);
+    scheduler.flush();
+    device->record_rx();
+    // Time spent held in the queue is not part of the round trip
+    ASSERT_EQ(device->get_rtt_histogram().count(), 1u);
+    EXPECT_LT(device->get_rtt_histogram().max(), 10000000u);
+}
+
+TEST_F(CANTxSchedulerTest, StopFramesGoFirstAndStaleFramesAreDiscarded) {
+    CANTxScheduler scheduler(faulty_);
+    TxStopFrames stop_frames;
+    stop_frames.can_frames = {make_frame(0x01, 0xFD), make_frame(0x02, 0xFD)};
+    scheduler.set_stop_frames(&stop_frames);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01, 0xFC), TxPriority::SAFETY);
+    scheduler.submit(make_frame(0x02, 0xAA), TxPriority::CONTROL);
+    scheduler.submit(make_frame(0x7FF, 0x01), TxPriority::CONFIG);
+
+    auto result = scheduler.stop();
+    EXPECT_EQ(result.written, 0);
+    EXPECT_EQ(result.pending, 2);
+    EXPECT_EQ(scheduler.flush(), 0u);
+    EXPECT_EQ(scheduler.stop_pending(), 2u);
+    // Stop frames are never dropped, whatever the retry limits
+    for (int i = 0; i < 10; ++i) scheduler.flush();
+    EXPECT_EQ(scheduler.stop_pending(), 2u);
+
+    set_refusing(false);
+    EXPECT_EQ(scheduler.flush(), 3u);
+    EXPECT_EQ(scheduler.stop_pending(), 0u);
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0].data[7], 0xFD);
+    EXPECT_EQ(frames[1].data[7], 0xFD);
+    EXPECT_EQ(frames[2].can_id, 0x7FFu);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::SAFETY).dropped_stop, 1u);
+    EXPECT_EQ(scheduler.get_stats(TxPriority::CONTROL).dropped_stop, 1u);
+}
+
+TEST_F(CANTxSchedulerTest, FramesSubmittedAfterAStopAreKept) {
+    CANTxScheduler scheduler(faulty_);
+    TxStopFrames stop_frames;
+    stop_frames.can_frames = {make_frame(0x01, 0xFD)};
+    scheduler.set_stop_frames(&stop_frames);
+    EXPECT_EQ(scheduler.stop().written, 1);
+    set_refusing(true);
+    scheduler.submit(make_frame(0x01, 0xFC), TxPriority::SAFETY);
+
+    set_refusing(false);
+    EXPECT_EQ(scheduler.flush(), 1u);
+    auto frames = read_all();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[1].data[7], 0xFC);
+}
@@ -0,0 +1,93 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/cycle_stats.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <string>
+
+namespace {
+
+using openarm::canbus::CyclePhase;
+using openarm::canbus::CyclePhaseTimer;
+using openarm::canbus::CycleStats;
+
+TEST(CycleStatsTest, EndCycleRecordsAccumulatedPhases) {
+    CycleStats stats;
+    stats.add(CyclePhase::ENCODE, 100);
+    stats.add(CyclePhase::ENCODE, 50);
+    stats.add(CyclePhase::DECODE, 30);
+    stats.end_cycle();
+
+    EXPECT_EQ(stats.get_cycles(), 1u);
+    EXPECT_EQ(stats.get_last_ns(CyclePhase::ENCODE), 150);
+    EXPECT_EQ(stats.get_last_ns(CyclePhase::DECODE), 30);
+    EXPECT_EQ(stats.get_last_ns(CyclePhase::TX), 0);
+    EXPECT_EQ(stats.get_histogram(CyclePhase::ENCODE).max(), 150u);
+
+    // Phases start from zero in the next cycle
+    stats.add(CyclePhase::ENCODE, 10);
+    stats.end_cycle();
+    EXPECT_EQ(stats.get_last_ns(CyclePhase::ENCODE), 10);
+    EXPECT_EQ(stats.get_histogram(CyclePhase::ENCODE).count(), 2u);
+
+    stats.reset();
+    EXPECT_EQ(stats.get_cycles(), 0u);
+    EXPECT_EQ(stats.get_histogram(CyclePhase::ENCODE).count(), 0u);
+}
+
+TEST(CycleStatsTest, TimerWithoutStatsIsNoop) {
+    CyclePhaseTimer timer(nullptr, CyclePhase::TX);
+}
+
+TEST(CycleStatsTest, PhaseNames) {
+    EXPECT_STREQ(openarm::canbus::to_string(CyclePhase::WAIT_FIRST_REPLY), "wait_first_reply");
+    EXPECT_STREQ(openarm::canbus::to_string(CyclePhase::DECODE), "decode");
+}
+
+TEST(CycleStatsTest, OpenArmTimesEachPhase) {
+    auto transport = std::make_unique<openarm::canbus::LoopbackTransport>(false, "cycle_test");
+    openarm::canbus::LoopbackTransport motor_side(false, "cycle_test");
+    openarm::canbus::LoopbackTransport::connect(*transport, motor_side);
+    openarm::can::socket::OpenArm openarm(std::move(transport));
+    openarm.init_arm_motors({openarm::damiao_motor::MotorType::DM4310}, {0x01}, {0x11});
+
+    openarm.get_arm().mit_control_all({{0, 0, 0, 0, 0}});
+    can_frame command{};
+    ASSERT_TRUE(motor_side.read_can_frame(command));
+    can_frame reply{};
+    reply.can_id = 0x11;
+    reply.can_dlc = 8;
+    reply.data[0] = 0x11;
+    ASSERT_TRUE(motor_side.write_can_frame(reply));
+    openarm.recv_all(1000);
+
+    const CycleStats& stats = openarm.get_cycle_stats();
+    EXPECT_EQ(stats.get_cycles(), 1u);
+    EXPECT_GT(stats.get_last_ns(CyclePhase::ENCODE), 0);
+    EXPECT_GT(stats.get_last_ns(CyclePhase::TX), 0);
+    EXPECT_GT(stats.get_last_ns(CyclePhase::WAIT_FIRST_REPLY), 0);
+    EXPECT_GT(stats.get_last_ns(CyclePhase::DRAIN), 0);
+    EXPECT_GT(stats.get_last_ns(CyclePhase::DECODE), 0);
+    // The reply was dispatched, closing the motor's round trip
+    EXPECT_EQ(openarm.get_arm().get_rtt_histogram(0).count(), 1u);
+
+    openarm.reset_cycle_stats();
+    EXPECT_EQ(openarm.get_cycle_stats().get_cycles(), 0u);
+}
+
+}  // namespace
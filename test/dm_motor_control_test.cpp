@@ -0,0 +1,303 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <openarm/damiao_motor/dm_motor.hpp>
+#include <openarm/damiao_motor/dm_motor_control.hpp>
+#include <openarm/damiao_motor/dm_motor_device.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+using openarm::damiao_motor::CanPacketDecoder;
+using openarm::damiao_motor::CanPacketEncoder;
+using openarm::damiao_motor::CANPacket;
+using openarm::damiao_motor::ControlMode;
+using openarm::damiao_motor::LimitParam;
+using openarm::damiao_motor::MOTOR_LIMIT_PARAMS;
+using openarm::damiao_motor::Motor;
+using openarm::damiao_motor::MotorStatus;
+using openarm::damiao_motor::MotorType;
+using Bytes = std::vector<uint8_t>;
+
+const Motor motor(MotorType::DM4310, 0x01, 0x11);
+
+LimitParam limits_of(MotorType motor_type) {
+    return MOTOR_LIMIT_PARAMS[static_cast<int>(motor_type)];
+}
+
+double lsb(double max, int bits) { return 2 * max / ((1 << bits) - 1); }
+
+// Move the q/dq/tau fields of an MIT command into the state reply layout;
+// both use 16/12/12 bits over the same ranges.
+Bytes mit_command_to_state(const Bytes& command) {
+    uint16_t q = (command[0] << 8) | command[1];
+    uint16_t dq = (command[2] << 4) | (command[3] >> 4);
+    uint16_t tau = ((command[6] & 0xF) << 8) | command[7];
+    return {0x11,
+            static_cast<uint8_t>(q >> 8),
+            static_cast<uint8_t>(q & 0xFF),
+            static_cast<uint8_t>(dq >> 4),
+            static_cast<uint8_t>(((dq & 0xF) << 4) | (tau >> 8)),
+            static_cast<uint8_t>(tau & 0xFF),
+            25,
+            30};
+}
+
+// Golden frames
+
+TEST(CanPacketEncoderTest, ConstantCommands) {
+    const std::vector<std::pair<CANPacket, uint8_t>> cases = {
+        {CanPacketEncoder::create_enable_command(motor), 0xFC},
+        {CanPacketEncoder::create_disable_command(motor), 0xFD},
+        {CanPacketEncoder::create_set_zero_command(motor), 0xFE},
+        {CanPacketEncoder::create_clear_error_command(motor), 0xFB},
+    };
+    for (const auto& [packet, command] : cases) {
+        EXPECT_EQ(packet.send_can_id, 0x01u);
+        EXPECT_EQ(packet.data, (Bytes{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, command}));
+    }
+}
+
+TEST(CanPacketEncoderTest, MITControlMaximum) {
+    auto packet = CanPacketEncoder::create_mit_control_command(motor, {500, 5, 12.5, 30, 10});
+    EXPECT_EQ(packet.send_can_id, 0x01u);
+    EXPECT_EQ(packet.data, (Bytes{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+}
+
+TEST(CanPacketEncoderTest, MITControlMinimum) {
+    auto packet = CanPacketEncoder::create_mit_control_command(motor, {0, 0, -12.5, -30, -10});
+    EXPECT_EQ(packet.data, (Bytes{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+}
+
+TEST(CanPacketEncoderTest, MITControlCenter) {
+    auto packet = CanPacketEncoder::create_mit_control_command(motor, {0, 0, 0, 0, 0});
+    // 0x7FFF / 0x7FF: the midpoint truncates down
+    EXPECT_EQ(packet.data, (Bytes{0x7F, 0xFF, 0x7F, 0xF0, 0x00, 0x00, 0x07, 0xFF}));
+}
+
+TEST(CanPacketEncoderTest, PosVelControl) {
+    auto packet = CanPacketEncoder::create_posvel_control_command(motor, {1.0, 2.0});
+    EXPECT_EQ(packet.send_can_id, 0x101u);
+    EXPECT_EQ(packet.data, (Bytes{0x00, 0x00, 0x80, 0x3F, 0x00, 0x00, 0x00, 0x40}));
+}
+
+TEST(CanPacketEncoderTest, VelControl) {
+    auto packet = CanPacketEncoder::create_vel_control_command(motor, {-1.0});
+    EXPECT_EQ(packet.send_can_id, 0x201u);
+    EXPECT_EQ(packet.data, (Bytes{0x00, 0x00, 0x80, 0xBF}));
+}
+
+TEST(CanPacketEncoderTest, PosForceControl) {
+    auto packet = CanPacketEncoder::create_posforce_control_command(motor, {1.0, 10.0, 0.5});
+    EXPECT_EQ(packet.send_can_id, 0x301u);
+    EXPECT_EQ(packet.data, (Bytes{0x00, 0x00, 0x80, 0x3F, 0xE8, 0x03, 0x88, 0x13}));
+}
+
+TEST(CanPacketEncoderTest, QueryParam) {
+    auto packet = CanPacketEncoder::create_query_param_command(motor, 7);
+    EXPECT_EQ(packet.send_can_id, 0x7FFu);
+    EXPECT_EQ(packet.data, (Bytes{0x01, 0x00, 0x33, 0x07, 0x00, 0x00, 0x00, 0x00}));
+}
+
+TEST(CanPacketEncoderTest, SetControlMode) {
+    auto packet = CanPacketEncoder::create_set_control_mode_command(motor, ControlMode::POS_VEL);
+    EXPECT_EQ(packet.send_can_id, 0x7FFu);
+    EXPECT_EQ(packet.data, (Bytes{0x01, 0x00, 0x55, 0x0A, 0x02, 0x00, 0x00, 0x00}));
+}
+
+TEST(CanPacketEncoderTest, Refresh) {
+    auto packet = CanPacketEncoder::create_refresh_command(motor);
+    EXPECT_EQ(packet.send_can_id, 0x7FFu);
+    EXPECT_EQ(packet.data, (Bytes{0x01, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00}));
+}
+
+TEST(CanPacketDecoderTest, State) {
+    const Bytes data = {0x11, 0xFF, 0xFF, 0x00, 0x0F, 0xFF, 40, 45};
+    auto result = CanPacketDecoder::parse_motor_state_data(motor, data);
+    ASSERT_TRUE(result.valid);
+    EXPECT_EQ(result.status, MotorStatus::ENABLED);
+    EXPECT_DOUBLE_EQ(result.position, 12.5);
+    EXPECT_DOUBLE_EQ(result.velocity, -30.0);
+    EXPECT_DOUBLE_EQ(result.torque, 10.0);
+    EXPECT_EQ(result.t_mos, 40);
+    EXPECT_EQ(result.t_rotor, 45);
+}
+
+TEST(CanPacketDecoderTest, FaultStatus) {
+    auto result =
+        CanPacketDecoder::parse_motor_state_data(motor, {0xA1, 0x80, 0x00, 0x80, 0x08, 0x00, 0, 0});
+    ASSERT_TRUE(result.valid);
+    EXPECT_EQ(result.status, MotorStatus::OVER_CURRENT);
+}
+
+TEST(CanPacketDecoderTest, UndocumentedStatusIsUnknown) {
+    for (uint8_t nibble : {0x2, 0x7, 0xF}) {
+        auto result = CanPacketDecoder::parse_motor_state_data(
+            motor, {static_cast<uint8_t>(nibble << 4 | 0x1), 0x80, 0x00, 0x80, 0x08, 0x00, 0, 0});
+        ASSERT_TRUE(result.valid);
+        EXPECT_EQ(result.status, MotorStatus::UNKNOWN);
+        EXPECT_FALSE(openarm::damiao_motor::is_fault_status(result.status));
+    }
+}
+
+TEST(CanPacketDecoderTest, ReportedStatusLeavesEnabledFlag) {
+    Motor reporting_motor(MotorType::DM4310, 0x01, 0x11);
+    openarm::damiao_motor::DMCANDevice device(reporting_motor, CAN_SFF_MASK, false);
+    can_frame frame{};
+    frame.can_id = 0x11;
+    frame.can_dlc = 8;
+    const Bytes data = {0x11, 0x80, 0x00, 0x80, 0x08, 0x00, 30, 30};
+    std::copy(data.begin(), data.end(), frame.data);
+
+    device.callback(frame);
+    EXPECT_EQ(reporting_motor.get_status(), MotorStatus::ENABLED);
+    EXPECT_FALSE(reporting_motor.is_enabled());
+}
+
+TEST(CanPacketDecoderTest, IntegerParam) {
+    auto result =
+        CanPacketDecoder::parse_motor_param_data({0x01, 0x00, 0x33, 0x07, 0x11, 0x00, 0x00, 0x00});
+    ASSERT_TRUE(result.valid);
+    EXPECT_EQ(result.rid, 7);
+    EXPECT_EQ(result.value, 0x11);
+}
+
+TEST(CanPacketDecoderTest, FloatParam) {
+    auto result =
+        CanPacketDecoder::parse_motor_param_data({0x01, 0x00, 0x55, 0x15, 0x00, 0x00, 0x48, 0x41});
+    ASSERT_TRUE(result.valid);
+    EXPECT_EQ(result.rid, 21);
+    EXPECT_FLOAT_EQ(result.value, 12.5f);
+}
+
+// Round trip
+
+class CodecRoundTripTest : public ::testing::TestWithParam<MotorType> {};
+
+TEST_P(CodecRoundTripTest, MITStateWithinOneLSB) {
+    const Motor typed_motor(GetParam(), 0x01, 0x11);
+    const LimitParam limits = limits_of(GetParam());
+    for (int step = 0; step <= 100; ++step) {
+        double ratio = -1.0 + step * 0.02;
+        double q = ratio * limits.pMax;
+        double dq = -ratio * limits.vMax;
+        double tau = ratio * limits.tMax * 0.5;
+        auto packet = CanPacketEncoder::create_mit_control_command(typed_motor, {0, 0, q, dq, tau});
+        auto result = CanPacketDecoder::parse_motor_state_data(
+            typed_motor, mit_command_to_state(packet.data));
+        ASSERT_TRUE(result.valid);
+        EXPECT_NEAR(result.position, q, lsb(limits.pMax, 16)) << "ratio " << ratio;
+        EXPECT_NEAR(result.velocity, dq, lsb(limits.vMax, 12)) << "ratio " << ratio;
+        EXPECT_NEAR(result.torque, tau, lsb(limits.tMax, 12)) << "ratio " << ratio;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllMotorTypes, CodecRoundTripTest,
+                         ::testing::Values(MotorType::DM3507, MotorType::DM4310,
+                                           MotorType::DM4310_48V, MotorType::DM4340,
+                                           MotorType::DM4340_48V, MotorType::DM6006,
+                                           MotorType::DM8006, MotorType::DM8009,
+                                           MotorType::DM10010L, MotorType::DM10010,
+                                           MotorType::DMH3510, MotorType::DMH6215,
+                                           MotorType::DMG6220));
+
+// Clamping
+
+TEST(CanPacketEncoderTest, MITClampsOutOfRange) {
+    auto over = CanPacketEncoder::create_mit_control_command(motor, {1000, 50, 100, 100, 100});
+    auto at_max = CanPacketEncoder::create_mit_control_command(motor, {500, 5, 12.5, 30, 10});
+    EXPECT_EQ(over.data, at_max.data);
+
+    auto under = CanPacketEncoder::create_mit_control_command(motor, {-1, -1, -100, -100, -100});
+    auto at_min = CanPacketEncoder::create_mit_control_command(motor, {0, 0, -12.5, -30, -10});
+    EXPECT_EQ(under.data, at_min.data);
+}
+
+TEST(CanPacketEncoderTest, PosForceClampsLimits) {
+    auto over = CanPacketEncoder::create_posforce_control_command(motor, {0.0, 1000.0, 2.0});
+    EXPECT_EQ(over.data[4] | (over.data[5] << 8), 10000);
+    EXPECT_EQ(over.data[6] | (over.data[7] << 8), 10000);
+
+    auto under = CanPacketEncoder::create_posforce_control_command(motor, {0.0, -1.0, -1.0});
+    EXPECT_EQ(under.data[4] | (under.data[5] << 8), 0);
+    EXPECT_EQ(under.data[6] | (under.data[7] << 8), 0);
+}
+
+TEST(CanPacketDecoderTest, StateStaysWithinLimits) {
+    auto low = CanPacketDecoder::parse_motor_state_data(motor, Bytes(8, 0x00));
+    auto high = CanPacketDecoder::parse_motor_state_data(motor, Bytes(8, 0xFF));
+    const LimitParam limits = limits_of(MotorType::DM4310);
+    EXPECT_DOUBLE_EQ(low.position, -limits.pMax);
+    EXPECT_DOUBLE_EQ(low.velocity, -limits.vMax);
+    EXPECT_DOUBLE_EQ(low.torque, -limits.tMax);
+    EXPECT_DOUBLE_EQ(high.position, limits.pMax);
+    EXPECT_DOUBLE_EQ(high.velocity, limits.vMax);
+    EXPECT_DOUBLE_EQ(high.torque, limits.tMax);
+}
+
+// Malformed input
+
+TEST(CanPacketDecoderTest, ShortFramesAreInvalid) {
+    for (size_t length = 0; length < 8; ++length) {
+        Bytes data(length, 0x33);
+        EXPECT_FALSE(CanPacketDecoder::parse_motor_state_data(motor, data).valid) << length;
+        EXPECT_FALSE(CanPacketDecoder::parse_motor_param_data(data).valid) << length;
+    }
+}
+
+TEST(CanPacketDecoderTest, FuzzStateData) {
+    std::mt19937 rng(20250101);
+    std::uniform_int_distribution<int> length_dist(0, 64);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+    const LimitParam limits = limits_of(MotorType::DM4310);
+    for (int i = 0; i < 10000; ++i) {
+        Bytes data(length_dist(rng));
+        for (auto& byte : data) byte = static_cast<uint8_t>(byte_dist(rng));
+        auto result = CanPacketDecoder::parse_motor_state_data(motor, data);
+        ASSERT_EQ(result.valid, data.size() >= 8);
+        if (!result.valid) continue;
+        ASSERT_TRUE(std::isfinite(result.position));
+        ASSERT_LE(std::abs(result.position), limits.pMax);
+        ASSERT_LE(std::abs(result.velocity), limits.vMax);
+        ASSERT_LE(std::abs(result.torque), limits.tMax);
+        if (result.status != MotorStatus::UNKNOWN) {
+            ASSERT_EQ(static_cast<int>(result.status), data[0] >> 4);
+        }
+    }
+}
+
+TEST(CanPacketDecoderTest, FuzzParamData) {
+    std::mt19937 rng(20250102);
+    std::uniform_int_distribution<int> length_dist(0, 64);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+    for (int i = 0; i < 10000; ++i) {
+        Bytes data(length_dist(rng));
+        for (auto& byte : data) byte = static_cast<uint8_t>(byte_dist(rng));
+        // Bias half of the inputs towards a valid reply command byte
+        if (data.size() > 2 && (i & 1)) data[2] = (i & 2) ? 0x33 : 0x55;
+        auto result = CanPacketDecoder::parse_motor_param_data(data);
+        bool expected = data.size() >= 8 && (data[2] == 0x33 || data[2] == 0x55);
+        ASSERT_EQ(result.valid, expected);
+        if (result.valid) {
+            ASSERT_EQ(result.rid, data[3]);
+        }
+    }
+}
+
+}  // namespace
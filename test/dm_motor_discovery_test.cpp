@@ -0,0 +1,127 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/damiao_motor/dm_motor.hpp>
+#include <openarm/damiao_motor/dm_motor_constants.hpp>
+#include <openarm/damiao_motor/dm_motor_control.hpp>
+#include <openarm/damiao_motor/dm_motor_discovery.hpp>
+#include <openarm/damiao_motor/dm_motor_simulator.hpp>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::LoopbackTransport;
+using openarm::damiao_motor::DiscoveryOptions;
+using openarm::damiao_motor::DMMotorSimulator;
+using openarm::damiao_motor::MotorType;
+
+std::vector<uint32_t> id_range(uint32_t first, uint32_t last) {
+    std::vector<uint32_t> ids;
+    for (uint32_t id = first; id <= last; ++id) ids.push_back(id);
+    return ids;
+}
+
+class DiscoveryTest : public ::testing::TestWithParam<bool> {
+protected:
+    DiscoveryTest() : host_(GetParam()), motor_side_(GetParam()), simulator_(motor_side_) {
+        LoopbackTransport::connect(host_, motor_side_);
+        host_.set_tx_handler([this](const canfd_frame& frame, bool is_fd) {
+            simulator_.handle_frame(frame, is_fd);
+        });
+    }
+
+    LoopbackTransport host_;
+    LoopbackTransport motor_side_;
+    DMMotorSimulator simulator_;
+};
+
+TEST_P(DiscoveryTest, FindsMotorsAndTheirMasterIDs) {
+    simulator_.add_motor(MotorType::DM4310, 0x03, 0x13);
+    simulator_.add_motor(MotorType::DM8009, 0x01, 0x11);
+    simulator_.add_motor(MotorType::DM4310, 0x7F, 0x00);
+
+    DiscoveryOptions options;
+    options.window_us = 5000;
+    auto motors = openarm::damiao_motor::discover_motors(host_, id_range(1, 0x7F), options);
+
+    ASSERT_EQ(motors.size(), 3u);
+    EXPECT_EQ(motors[0].slave_id, 0x01u);
+    EXPECT_EQ(motors[0].master_id, 0x11u);
+    EXPECT_EQ(motors[1].slave_id, 0x03u);
+    EXPECT_EQ(motors[1].master_id, 0x13u);
+    EXPECT_EQ(motors[2].slave_id, 0x7Fu);
+    EXPECT_EQ(motors[2].master_id, 0x00u);
+    // Every ID was queried once per round, answered ones only in the first
+    EXPECT_EQ(simulator_.get_frames_received(), 0x7Fu + 2 * (0x7Fu - 3));
+}
+
+TEST_P(DiscoveryTest, SilentBusTakesOneWindowPerRound) {
+    DiscoveryOptions options;
+    options.window_us = 10000;
+    options.retries = 1;
+    auto start = std::chrono::steady_clock::now();
+    auto motors = openarm::damiao_motor::discover_motors(host_, id_range(1, 16), options);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(motors.empty());
+    EXPECT_EQ(simulator_.get_frames_received(), 32u);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+INSTANTIATE_TEST_SUITE_P(ClassicAndFD, DiscoveryTest, ::testing::Bool());
+
+TEST(DiscoveryQueryTest, IgnoresAnotherHostsQueries) {
+    LoopbackTransport host(false);
+    // Another host on the bus queries the same IDs; nothing answers
+    host.set_tx_handler([&](const canfd_frame& frame, bool) {
+        can_frame foreign{};
+        foreign.can_id = frame.can_id;
+        foreign.can_dlc = 8;
+        std::copy(frame.data, frame.data + 8, foreign.data);
+        host.inject(foreign);
+    });
+    DiscoveryOptions options;
+    options.window_us = 1000;
+    options.retries = 0;
+    auto motors = openarm::damiao_motor::discover_motors(host, id_range(1, 4), options);
+    EXPECT_TRUE(motors.empty());
+}
+
+TEST(DiscoveryQueryTest, MatchesTheEncoderQuery) {
+    LoopbackTransport host(false);
+    std::vector<canfd_frame> queries;
+    host.set_tx_handler([&](const canfd_frame& frame, bool) { queries.push_back(frame); });
+    DiscoveryOptions options;
+    options.window_us = 1000;
+    options.retries = 0;
+    openarm::damiao_motor::discover_motors(host, {0x105}, options);
+
+    ASSERT_EQ(queries.size(), 1u);
+    openarm::damiao_motor::Motor motor(MotorType::DM4310, 0x105, 0x115);
+    auto packet = openarm::damiao_motor::CanPacketEncoder::create_query_param_command(
+        motor, static_cast<int>(openarm::damiao_motor::RID::MST_ID));
+    EXPECT_EQ(queries[0].can_id, packet.send_can_id);
+    ASSERT_EQ(queries[0].len, packet.data.size());
+    EXPECT_EQ(std::vector<uint8_t>(queries[0].data, queries[0].data + queries[0].len),
+              packet.data);
+}
+
+}  // namespace
@@ -0,0 +1,296 @@
+// Copyright 2026 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/damiao_motor/dm_motor.hpp>
+#include <openarm/damiao_motor/dm_motor_control.hpp>
+#include <openarm/damiao_motor/dm_motor_simulator.hpp>
+#include <optional>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::LoopbackTransport;
+using openarm::damiao_motor::CanPacketDecoder;
+using openarm::damiao_motor::CanPacketEncoder;
+using openarm::damiao_motor::CANPacket;
+using openarm::damiao_motor::ControlMode;
+using openarm::damiao_motor::DMMotorSimulator;
+using openarm::damiao_motor::MITParam;
+using openarm::damiao_motor::MOTOR_LIMIT_PARAMS;
+using openarm::damiao_motor::Motor;
+using openarm::damiao_motor::MotorStatus;
+using openarm::damiao_motor::MotorType;
+using openarm::damiao_motor::PosForceParam;
+using openarm::damiao_motor::PosVelParam;
+using openarm::damiao_motor::RID;
+using openarm::damiao_motor::SimulatedMotor;
+using openarm::damiao_motor::VelParam;
+using Bytes = std::vector<uint8_t>;
+
+class DMMotorSimulatorTest : public ::testing::Test {
+protected:
+    DMMotorSimulatorTest() : simulator_(motor_side_) {
+        LoopbackTransport::connect(host_, motor_side_);
+        host_.set_tx_handler([this](const canfd_frame& frame, bool is_fd) {
+            simulator_.handle_frame(frame, is_fd);
+        });
+        simulator_.add_motor(MotorType::DM4310, 0x03, 0x13);
+    }
+
+    void send(const CANPacket& packet) {
+        can_frame frame{};
+        frame.can_id = packet.send_can_id;
+        frame.can_dlc = static_cast<uint8_t>(packet.data.size());
+        std::memcpy(frame.data, packet.data.data(), packet.data.size());
+        ASSERT_TRUE(host_.write_can_frame(frame));
+    }
+
+    std::optional<can_frame> reply() {
+        can_frame frame;
+        if (!host_.read_can_frame(frame)) return std::nullopt;
+        return frame;
+    }
+
+    // Switch mode, enable and send one setpoint, dropping the replies
+    void command(ControlMode mode, const CANPacket& setpoint) {
+        send(CanPacketEncoder::create_set_control_mode_command(motor_, mode));
+        send(CanPacketEncoder::create_enable_command(motor_));
+        send(setpoint);
+        while (reply()) {
+        }
+    }
+
+    // Step the physics at 1 kHz, calling observe after every step
+    void run(double seconds, const std::function<void(const SimulatedMotor&)>& observe = {}) {
+        constexpr double kDt = 0.001;
+        for (int i = 0; i < static_cast<int>(seconds / kDt); ++i) {
+            simulator_.step(kDt);
+            if (observe) observe(simulator_.get_motor(0x03));
+        }
+    }
+
+    static Bytes payload(const can_frame& frame) {
+        return Bytes(frame.data, frame.data + frame.can_dlc);
+    }
+
+    LoopbackTransport host_;
+    LoopbackTransport motor_side_;
+    DMMotorSimulator simulator_;
+    const Motor motor_{MotorType::DM4310, 0x03, 0x13};
+};
+
+TEST_F(DMMotorSimulatorTest, EnableAndDisableReplyWithStatus) {
+    send(CanPacketEncoder::create_enable_command(motor_));
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->can_id, 0x13u);
+    EXPECT_EQ(frame->data[0], 0x13);  // ENABLED nibble, slave ID nibble
+    EXPECT_EQ(simulator_.get_motor(0x03).status, MotorStatus::ENABLED);
+
+    send(CanPacketEncoder::create_disable_command(motor_));
+    frame = reply();
+    ASSERT_TRUE(frame);
+    auto state = CanPacketDecoder::parse_motor_state_data(motor_, payload(*frame));
+    ASSERT_TRUE(state.valid);
+    EXPECT_EQ(state.status, MotorStatus::DISABLED);
+    EXPECT_EQ(state.t_mos, 30);
+}
+
+TEST_F(DMMotorSimulatorTest, SetZeroMovesOriginToCurrentPosition) {
+    send(CanPacketEncoder::create_enable_command(motor_));
+    send(CanPacketEncoder::create_mit_control_command(motor_, MITParam{0, 0, 0, 0, 1.0}));
+    simulator_.step(0.1);
+    ASSERT_GT(simulator_.get_motor(0x03).position, 0.01);
+    while (reply()) {
+    }
+
+    send(CanPacketEncoder::create_set_zero_command(motor_));
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    auto state = CanPacketDecoder::parse_motor_state_data(motor_, payload(*frame));
+    EXPECT_NEAR(state.position, 0.0, 1e-3);
+    EXPECT_EQ(simulator_.get_motor(0x03).position, 0.0);
+}
+
+TEST_F(DMMotorSimulatorTest, FaultIsLatchedUntilClearError) {
+    simulator_.inject_fault(0x03, MotorStatus::OVER_CURRENT);
+    send(CanPacketEncoder::create_enable_command(motor_));
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data[0] >> 4, static_cast<int>(MotorStatus::OVER_CURRENT));
+
+    send(CanPacketEncoder::create_clear_error_command(motor_));
+    frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data[0] >> 4, static_cast<int>(MotorStatus::DISABLED));
+
+    send(CanPacketEncoder::create_enable_command(motor_));
+    frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data[0] >> 4, static_cast<int>(MotorStatus::ENABLED));
+}
+
+TEST_F(DMMotorSimulatorTest, RefreshRepliesWithState) {
+    send(CanPacketEncoder::create_refresh_command(motor_));
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->can_id, 0x13u);
+    EXPECT_TRUE(CanPacketDecoder::parse_motor_state_data(motor_, payload(*frame)).valid);
+}
+
+TEST_F(DMMotorSimulatorTest, RegisterReadReturnsIntegerAndFloatValues) {
+    send(CanPacketEncoder::create_query_param_command(motor_, static_cast<int>(RID::MST_ID)));
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data[0], 0x03);
+    EXPECT_EQ(frame->data[2], 0x33);
+    auto param = CanPacketDecoder::parse_motor_param_data(payload(*frame));
+    ASSERT_TRUE(param.valid);
+    EXPECT_EQ(param.rid, static_cast<int>(RID::MST_ID));
+    EXPECT_EQ(param.value, 0x13);
+
+    send(CanPacketEncoder::create_query_param_command(motor_, static_cast<int>(RID::TMAX)));
+    frame = reply();
+    ASSERT_TRUE(frame);
+    param = CanPacketDecoder::parse_motor_param_data(payload(*frame));
+    ASSERT_TRUE(param.valid);
+    EXPECT_FLOAT_EQ(param.value, 10.0);
+}
+
+TEST_F(DMMotorSimulatorTest, RegisterWriteIsEchoedAndApplied) {
+    send(CanPacketEncoder::create_set_control_mode_command(motor_, ControlMode::VEL));
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data[2], 0x55);
+    auto param = CanPacketDecoder::parse_motor_param_data(payload(*frame));
+    ASSERT_TRUE(param.valid);
+    EXPECT_EQ(param.rid, static_cast<int>(RID::CTRL_MODE));
+    EXPECT_EQ(param.value, static_cast<int>(ControlMode::VEL));
+    EXPECT_EQ(simulator_.get_motor(0x03).control_mode, ControlMode::VEL);
+
+    // The motor now ignores the MIT control ID
+    send(CanPacketEncoder::create_mit_control_command(motor_, MITParam{0, 0, 0, 0, 1.0}));
+    EXPECT_FALSE(reply());
+
+    send(CanPacketEncoder::create_query_param_command(motor_, static_cast<int>(RID::CTRL_MODE)));
+    frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(CanPacketDecoder::parse_motor_param_data(payload(*frame)).value,
+              static_cast<int>(ControlMode::VEL));
+}
+
+TEST_F(DMMotorSimulatorTest, SaveIsAcknowledged) {
+    send({0x7FF, {0x03, 0x00, 0xAA, 0x01, 0x00, 0x00, 0x00, 0x00}});
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->can_id, 0x13u);
+    EXPECT_EQ(payload(*frame), (Bytes{0x03, 0x00, 0xAA, 0x01, 0x00, 0x00, 0x00, 0x00}));
+}
+
+TEST_F(DMMotorSimulatorTest, UnknownSlaveIsSilent) {
+    Motor other(MotorType::DM4310, 0x04, 0x14);
+    send(CanPacketEncoder::create_enable_command(other));
+    send(CanPacketEncoder::create_query_param_command(other, static_cast<int>(RID::MST_ID)));
+    EXPECT_FALSE(reply());
+    EXPECT_EQ(simulator_.get_frames_received(), 2u);
+    EXPECT_EQ(simulator_.get_frames_replied(), 0u);
+}
+
+TEST_F(DMMotorSimulatorTest, RepliesWaitForTheConfiguredLatency) {
+    simulator_.set_reply_latency_us(20000);
+    auto start = std::chrono::steady_clock::now();
+    send(CanPacketEncoder::create_enable_command(motor_));
+    EXPECT_EQ(host_.rx_pending(), 0u);
+
+    while (host_.rx_pending() == 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) {
+        simulator_.poll(1000);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(reply());
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+TEST_F(DMMotorSimulatorTest, MITStepSettlesWithoutOvershoot) {
+    // kp 20 and kd 1 on 0.01 kg m^2 is slightly overdamped
+    command(ControlMode::MIT, CanPacketEncoder::create_mit_control_command(
+                                  motor_, MITParam{20.0, 1.0, 1.0, 0.0, 0.0}));
+    double peak = 0.0;
+    run(1.0, [&](const SimulatedMotor& motor) { peak = std::max(peak, motor.position); });
+
+    SimulatedMotor motor = simulator_.get_motor(0x03);
+    EXPECT_NEAR(motor.position, 1.0, 0.01);
+    EXPECT_NEAR(motor.velocity, 0.0, 0.01);
+    EXPECT_LT(peak, 1.02);
+}
+
+TEST_F(DMMotorSimulatorTest, PosVelStepRespectsTheSpeedLimit) {
+    command(ControlMode::POS_VEL,
+            CanPacketEncoder::create_posvel_control_command(motor_, PosVelParam{2.0, 4.0}));
+    double top_speed = 0.0;
+    run(1.5, [&](const SimulatedMotor& motor) {
+        top_speed = std::max(top_speed, std::abs(motor.velocity));
+    });
+
+    SimulatedMotor motor = simulator_.get_motor(0x03);
+    EXPECT_NEAR(motor.position, 2.0, 0.01);
+    EXPECT_NEAR(top_speed, 4.0, 0.1);
+}
+
+TEST_F(DMMotorSimulatorTest, VelStepReachesTargetSpeed) {
+    command(ControlMode::VEL, CanPacketEncoder::create_vel_control_command(motor_, VelParam{3.0}));
+    run(0.1);
+    // Damping leaves a steady-state error of b / (J * bandwidth + b), about 1%
+    EXPECT_NEAR(simulator_.get_motor(0x03).velocity, 3.0, 0.05);
+}
+
+TEST_F(DMMotorSimulatorTest, PosForceStepStaysWithinTheCurrentLimit) {
+    double tau_max = MOTOR_LIMIT_PARAMS[static_cast<int>(MotorType::DM4310)].tMax;
+    command(ControlMode::POS_FORCE, CanPacketEncoder::create_posforce_control_command(
+                                        motor_, PosForceParam{1.0, 5.0, 0.3}));
+    double peak_torque = 0.0;
+    run(1.5, [&](const SimulatedMotor& motor) {
+        peak_torque = std::max(peak_torque, std::abs(motor.torque));
+    });
+
+    EXPECT_NEAR(simulator_.get_motor(0x03).position, 1.0, 0.01);
+    EXPECT_LE(peak_torque, 0.3 * tau_max + 1e-3);
+    // The limit was the binding constraint while accelerating
+    EXPECT_NEAR(peak_torque, 0.3 * tau_max, 0.01);
+}
+
+TEST_F(DMMotorSimulatorTest, TorqueIsClampedToTMax) {
+    double tau_max = MOTOR_LIMIT_PARAMS[static_cast<int>(MotorType::DM4310)].tMax;
+    command(ControlMode::MIT, CanPacketEncoder::create_mit_control_command(
+                                  motor_, MITParam{500.0, 0.0, 10.0, 0.0, 0.0}));
+    run(0.01);
+    EXPECT_DOUBLE_EQ(simulator_.get_motor(0x03).torque, tau_max);
+
+    // The state reply reports the clamped torque too
+    send(CanPacketEncoder::create_refresh_command(motor_));
+    auto frame = reply();
+    ASSERT_TRUE(frame);
+    auto state = CanPacketDecoder::parse_motor_state_data(motor_, payload(*frame));
+    EXPECT_NEAR(state.torque, tau_max, 2 * tau_max / 4095);
+}
+
+}  // namespace
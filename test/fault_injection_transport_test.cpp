@@ -0,0 +1,125 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <openarm/canbus/fault_injection_transport.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::FaultInjectionTransport;
+using openarm::canbus::FaultProfile;
+using openarm::canbus::LoopbackTransport;
+
+can_frame make_frame(canid_t can_id) {
+    can_frame frame{};
+    frame.can_id = can_id;
+    frame.can_dlc = 8;
+    for (int i = 0; i < 8; ++i) frame.data[i] = static_cast<uint8_t>(0x10 * i + can_id);
+    return frame;
+}
+
+class FaultInjectionTransportTest : public ::testing::Test {
+protected:
+    void SetUp() override { LoopbackTransport::connect(near_, far_); }
+
+    std::vector<can_frame> read_all(openarm::canbus::CANTransport& transport) {
+        std::vector<can_frame> frames;
+        can_frame frame;
+        while (transport.read_can_frame(frame)) frames.push_back(frame);
+        return frames;
+    }
+
+    LoopbackTransport near_;
+    LoopbackTransport far_;
+    FaultInjectionTransport faulty_{near_};
+};
+
+TEST_F(FaultInjectionTransportTest, DropsLookWrittenToTheSender) {
+    FaultProfile profile;
+    profile.drop_probability = 1.0;
+    faulty_.set_tx_profile(profile);
+
+    std::vector<can_frame> frames = {make_frame(1), make_frame(2), make_frame(3)};
+    EXPECT_EQ(faulty_.write_can_frames(frames.data(), frames.size()), 3);
+    EXPECT_EQ(far_.rx_pending(), 0u);
+    EXPECT_EQ(faulty_.get_tx_stats().dropped, 3u);
+}
+
+TEST_F(FaultInjectionTransportTest, Duplicates) {
+    FaultProfile profile;
+    profile.duplicate_probability = 1.0;
+    faulty_.set_tx_profile(profile);
+
+    EXPECT_TRUE(faulty_.write_can_frame(make_frame(1)));
+    EXPECT_EQ(far_.rx_pending(), 2u);
+}
+
+TEST_F(FaultInjectionTransportTest, DelaysUntilDue) {
+    FaultProfile profile;
+    profile.delay_us = 2000;
+    faulty_.set_tx_profile(profile);
+
+    EXPECT_TRUE(faulty_.write_can_frame(make_frame(1)));
+    EXPECT_EQ(far_.rx_pending(), 0u);
+    // Waiting on the decorator releases the delayed frame
+    faulty_.is_data_available(10000);
+    EXPECT_EQ(far_.rx_pending(), 1u);
+}
+
+TEST_F(FaultInjectionTransportTest, DelayedReceiveWakesUpWaiter) {
+    FaultProfile profile;
+    profile.delay_us = 2000;
+    faulty_.set_rx_profile(profile);
+
+    far_.write_can_frame(make_frame(1));
+    can_frame frame;
+    EXPECT_FALSE(faulty_.read_can_frame(frame));
+    EXPECT_TRUE(faulty_.is_data_available(100000));
+    EXPECT_EQ(read_all(faulty_).size(), 1u);
+}
+
+TEST_F(FaultInjectionTransportTest, CorruptsOneBit) {
+    FaultProfile profile;
+    profile.corrupt_probability = 1.0;
+    faulty_.set_rx_profile(profile);
+
+    can_frame sent = make_frame(1);
+    far_.write_can_frame(sent);
+    auto received = read_all(faulty_);
+    ASSERT_EQ(received.size(), 1u);
+    int flipped_bits = 0;
+    for (int i = 0; i < 8; ++i) {
+        flipped_bits += __builtin_popcount(sent.data[i] ^ received[0].data[i]);
+    }
+    EXPECT_EQ(flipped_bits, 1);
+}
+
+TEST_F(FaultInjectionTransportTest, ReordersPairs) {
+    FaultProfile profile;
+    profile.reorder_probability = 1.0;
+    faulty_.set_rx_profile(profile);
+
+    for (canid_t id = 1; id <= 4; ++id) far_.write_can_frame(make_frame(id));
+    auto received = read_all(faulty_);
+    ASSERT_EQ(received.size(), 4u);
+    EXPECT_EQ(received[0].can_id, 2u);
+    EXPECT_EQ(received[1].can_id, 1u);
+    EXPECT_EQ(received[2].can_id, 4u);
+    EXPECT_EQ(received[3].can_id, 3u);
+}
+
+}  // namespace
@@ -0,0 +1,163 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <openarm/canbus/can_device_collection.hpp>
+#include <openarm/canbus/frame_recorder.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::FrameDirection;
+using openarm::canbus::FrameLogReader;
+using openarm::canbus::FrameRecorder;
+using openarm::canbus::FrameRecorderOptions;
+using openarm::canbus::RecordedFrame;
+
+class FrameRecorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        options_.binary_path = testing::TempDir() + "openarm_frame_recorder_test.bin";
+        options_.text_path = testing::TempDir() + "openarm_frame_recorder_test.log";
+    }
+
+    void TearDown() override {
+        unlink(options_.binary_path.c_str());
+        unlink(options_.text_path.c_str());
+    }
+
+    std::vector<RecordedFrame> read_binary() {
+        FrameLogReader reader(options_.binary_path);
+        EXPECT_EQ(reader.get_interface(), "can0");
+        std::vector<RecordedFrame> frames;
+        RecordedFrame frame;
+        while (reader.next(frame)) frames.push_back(frame);
+        return frames;
+    }
+
+    std::vector<std::string> read_text() {
+        std::ifstream file(options_.text_path);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) lines.push_back(line);
+        return lines;
+    }
+
+    FrameRecorderOptions options_;
+};
+
+TEST_F(FrameRecorderTest, RecordsTransportWritesAndDispatch) {
+    FrameRecorder recorder("can0", options_);
+    openarm::canbus::LoopbackTransport transport(false, "can0");
+    openarm::canbus::CANDeviceCollection collection(transport);
+    transport.set_frame_recorder(&recorder);
+    collection.set_frame_recorder(&recorder);
+
+    can_frame command{};
+    command.can_id = 0x001;
+    command.can_dlc = 2;
+    command.data[0] = 0xAB;
+    command.data[1] = 0x01;
+    transport.write_can_frame(command);
+    can_frame reply{};
+    reply.can_id = 0x011;
+    reply.can_dlc = 1;
+    reply.data[0] = 0x7F;
+    collection.dispatch_frame_callback(reply);
+    recorder.flush();
+
+    auto frames = read_binary();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].direction, FrameDirection::TX);
+    EXPECT_EQ(frames[0].can_id, 0x001u);
+    EXPECT_EQ(frames[0].len, 2);
+    EXPECT_EQ(frames[0].data[0], 0xAB);
+    EXPECT_EQ(frames[1].direction, FrameDirection::RX);
+    EXPECT_EQ(frames[1].can_id, 0x011u);
+    EXPECT_LE(frames[0].timestamp_ns, frames[1].timestamp_ns);
+
+    auto lines = read_text();
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_TRUE(std::regex_match(lines[0], std::regex(R"(\(\d+\.\d{6}\) can0 001#AB01)")))
+        << lines[0];
+    EXPECT_TRUE(std::regex_match(lines[1], std::regex(R"(\(\d+\.\d{6}\) can0 011#7F)")))
+        << lines[1];
+}
+
+TEST_F(FrameRecorderTest, TextFormatsCanFdAndExtendedIds) {
+    {
+        FrameRecorder recorder("can0", options_);
+        canfd_frame fd_frame{};
+        fd_frame.can_id = 0x123;
+        fd_frame.len = 12;
+        fd_frame.flags = CANFD_BRS;
+        fd_frame.data[11] = 0xEE;
+        recorder.record(FrameDirection::TX, fd_frame);
+        can_frame extended{};
+        extended.can_id = 0x1ABCDEF0 | CAN_EFF_FLAG;
+        recorder.record(FrameDirection::RX, extended);
+    }
+
+    auto lines = read_text();
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[0].find(" can0 123##1" + std::string(22, '0') + "EE"), std::string::npos)
+        << lines[0];
+    EXPECT_NE(lines[1].find(" can0 1ABCDEF0#"), std::string::npos) << lines[1];
+    auto frames = read_binary();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_TRUE(frames[0].is_fd);
+    EXPECT_EQ(frames[0].len, 12);
+    EXPECT_EQ(frames[0].flags, CANFD_BRS);
+}
+
+TEST_F(FrameRecorderTest, FullRingDropsFrames) {
+    options_.ring_capacity = 4;
+    options_.drain_interval_ms = 1000;
+    FrameRecorder recorder("can0", options_);
+    can_frame frame{};
+    for (int i = 0; i < 100; ++i) recorder.record(FrameDirection::TX, frame);
+    EXPECT_GT(recorder.get_dropped(), 0u);
+    EXPECT_EQ(recorder.get_recorded() + recorder.get_dropped(), 100u);
+}
+
+TEST_F(FrameRecorderTest, ReaderStopsAtAnOversizedLength) {
+    {
+        FrameRecorder recorder("can0", options_);
+        can_frame frame{};
+        frame.can_dlc = 8;
+        recorder.record(FrameDirection::TX, frame);
+        recorder.record(FrameDirection::TX, frame);
+    }
+    {
+        // Length byte of the first record: file header, "can0", then byte 15
+        std::fstream file(options_.binary_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(16 + 4 + 15);
+        file.put(static_cast<char>(CANFD_MAX_DLEN + 1));
+    }
+    EXPECT_TRUE(read_binary().empty());
+}
+
+TEST_F(FrameRecorderTest, ReaderRejectsOtherFiles) {
+    { std::ofstream(options_.binary_path) << "not a frame log"; }
+    EXPECT_THROW(FrameLogReader reader(options_.binary_path), std::runtime_error);
+}
+
+}  // namespace
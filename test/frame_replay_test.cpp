@@ -0,0 +1,148 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <openarm/canbus/can_device_collection.hpp>
+#include <openarm/canbus/frame_recorder.hpp>
+#include <openarm/canbus/frame_replay.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/damiao_motor/dm_motor_device.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using openarm::canbus::FrameDirection;
+using openarm::canbus::ReplayOptions;
+using openarm::damiao_motor::CallbackMode;
+using openarm::damiao_motor::DMCANDevice;
+using openarm::damiao_motor::Motor;
+using openarm::damiao_motor::MotorType;
+
+class FrameReplayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = testing::TempDir() + "openarm_frame_replay_test.log";
+        device_ = std::make_shared<DMCANDevice>(motor_, CAN_SFF_MASK, false);
+        device_->set_callback_mode(CallbackMode::STATE);
+        collection_.add_device(device_);
+    }
+
+    void TearDown() override { unlink(path_.c_str()); }
+
+    void write_log(const std::string& contents) { std::ofstream(path_) << contents; }
+
+    std::string path_;
+    Motor motor_{MotorType::DM4310, 0x01, 0x11};
+    std::shared_ptr<DMCANDevice> device_;
+    openarm::canbus::LoopbackTransport transport_{false, "replay_test"};
+    openarm::canbus::CANDeviceCollection collection_{transport_};
+};
+
+TEST_F(FrameReplayTest, ParsesCandumpLog) {
+    write_log(
+        "(1700000000.000100) can0 011#01FFFF7FF7FF1E1E\n"
+        "(1700000000.000200) can0 12345678#00\n"
+        "(1700000000.000300) can0 123##1DEADBEEF\n"
+        "(1700000000.000400) can0 321#R\n");
+    auto frames = openarm::canbus::read_frame_log(path_);
+    ASSERT_EQ(frames.size(), 4u);
+    EXPECT_EQ(frames[0].timestamp_ns, 1700000000000100000ULL);
+    EXPECT_EQ(frames[0].can_id, 0x011u);
+    EXPECT_EQ(frames[0].len, 8);
+    EXPECT_EQ(frames[0].direction, FrameDirection::RX);
+    EXPECT_EQ(frames[1].can_id, 0x12345678u | CAN_EFF_FLAG);
+    EXPECT_TRUE(frames[2].is_fd);
+    EXPECT_EQ(frames[2].flags, 1);
+    EXPECT_EQ(frames[2].len, 4);
+    EXPECT_EQ(frames[3].can_id, 0x321u | CAN_RTR_FLAG);
+}
+
+TEST_F(FrameReplayTest, RejectsMalformedLines) {
+    write_log("(1700000000.000100) can0 011#01FFFF7FF7FF1E1E\nnot a frame\n");
+    EXPECT_THROW(openarm::canbus::read_frame_log(path_), std::runtime_error);
+}
+
+TEST_F(FrameReplayTest, RejectsOddLengthPayloads) {
+    write_log("(1700000000.000100) can0 123#ABC\n");
+    EXPECT_THROW(openarm::canbus::read_frame_log(path_), std::runtime_error);
+    write_log("(1700000000.000100) can0 123##1ABC\n");
+    EXPECT_THROW(openarm::canbus::read_frame_log(path_), std::runtime_error);
+}
+
+TEST_F(FrameReplayTest, AcceptsDotSeparatedPayloads) {
+    write_log("(1700000000.000100) can0 123#AB.CD.EF\n");
+    auto frames = openarm::canbus::read_frame_log(path_);
+    ASSERT_EQ(frames.size(), 1u);
+    ASSERT_EQ(frames[0].len, 3);
+    EXPECT_EQ(frames[0].data[2], 0xEF);
+}
+
+TEST_F(FrameReplayTest, DecodesReplayedStateFrames) {
+    write_log(
+        "(1700000000.000100) can0 001#FC\n"
+        "(1700000000.000200) can0 011#01FFFF7FF7FF1E1E\n"
+        "(1700000000.000300) can0 042#00\n");
+    auto frames = openarm::canbus::read_frame_log(path_);
+    ReplayOptions options;
+    options.speed = 0;
+    auto stats = openarm::canbus::replay_frames(frames, collection_, options);
+    EXPECT_EQ(stats.frames_dispatched, 3u);
+    EXPECT_EQ(device_->get_rx_frames(), 1u);
+    EXPECT_NEAR(motor_.get_position(), 12.5, 1e-3);
+    EXPECT_EQ(collection_.get_unknown_id_frames(), 2u);
+}
+
+TEST_F(FrameReplayTest, SkipsRecordedTxUnlessAsked) {
+    {
+        openarm::canbus::FrameRecorderOptions recorder_options;
+        recorder_options.binary_path = path_;
+        openarm::canbus::FrameRecorder recorder("can0", recorder_options);
+        can_frame frame{};
+        frame.can_id = 0x011;
+        frame.can_dlc = 8;
+        recorder.record(FrameDirection::TX, frame);
+        recorder.record(FrameDirection::RX, frame);
+    }
+    auto frames = openarm::canbus::read_frame_log(path_);
+    ASSERT_EQ(frames.size(), 2u);
+
+    ReplayOptions options;
+    options.speed = 0;
+    auto stats = openarm::canbus::replay_frames(frames, collection_, options);
+    EXPECT_EQ(stats.frames_dispatched, 1u);
+    EXPECT_EQ(stats.frames_skipped, 1u);
+    options.include_tx = true;
+    stats = openarm::canbus::replay_frames(frames, collection_, options);
+    EXPECT_EQ(stats.frames_dispatched, 2u);
+}
+
+TEST_F(FrameReplayTest, KeepsScaledTiming) {
+    write_log(
+        "(1700000000.000000) can0 011#01FFFF7FF7FF1E1E\n"
+        "(1700000000.200000) can0 011#01FFFF7FF7FF1E1E\n");
+    auto frames = openarm::canbus::read_frame_log(path_);
+    ReplayOptions options;
+    options.speed = 10;
+    auto stats = openarm::canbus::replay_frames(frames, collection_, options);
+    EXPECT_EQ(stats.frames_dispatched, 2u);
+    EXPECT_GE(stats.elapsed_s, 0.02);
+    EXPECT_LT(stats.elapsed_s, 0.2);
+}
+
+}  // namespace
@@ -0,0 +1,71 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <openarm/canbus/latency_histogram.hpp>
+
+namespace {
+
+using openarm::canbus::LatencyHistogram;
+
+TEST(LatencyHistogramTest, Empty) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_EQ(histogram.percentile(99), 0u);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 50; ++value) histogram.record(value);
+    EXPECT_EQ(histogram.percentile(50), 25u);
+    EXPECT_EQ(histogram.percentile(100), 50u);
+    EXPECT_EQ(histogram.min(), 1u);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    // 1 us .. 10 ms in 1 us steps
+    for (uint64_t value = 1000; value <= 10000000; value += 1000) histogram.record(value);
+    for (double percent : {50.0, 90.0, 99.0, 99.9}) {
+        double expected = percent / 100.0 * 10000000;
+        double actual = static_cast<double>(histogram.percentile(percent));
+        EXPECT_GE(actual, expected * 0.99) << percent;
+        EXPECT_LE(actual, expected * 1.04) << percent;
+    }
+    EXPECT_EQ(histogram.max(), 10000000u);
+    EXPECT_EQ(histogram.percentile(100), 10000000u);
+}
+
+TEST(LatencyHistogramTest, HugeValues) {
+    LatencyHistogram histogram;
+    histogram.record(UINT64_MAX);
+    EXPECT_EQ(histogram.percentile(50), UINT64_MAX);
+}
+
+TEST(LatencyHistogramTest, Merge) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(100);
+    b.record(300000);
+    a.merge(b);
+    EXPECT_EQ(a.count(), 2u);
+    EXPECT_EQ(a.min(), 100u);
+    EXPECT_EQ(a.max(), 300000u);
+    EXPECT_DOUBLE_EQ(a.mean(), 150050.0);
+}
+
+}  // namespace
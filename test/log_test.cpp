@@ -0,0 +1,93 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <openarm/canbus/log.hpp>
+#include <openarm/canbus/metrics.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::LogLevel;
+using openarm::canbus::Logger;
+using openarm::canbus::LogThrottle;
+using openarm::canbus::MetricsRegistry;
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        logger_.set_sink([this](LogLevel level, const char* message) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            messages_.push_back(std::string(to_string(level)) + ": " + message);
+        });
+    }
+
+    std::vector<std::string> messages() {
+        logger_.flush();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+    // Declared before the logger, which may still call the sink while it
+    // is destroyed
+    std::mutex mutex_;
+    std::vector<std::string> messages_;
+    MetricsRegistry registry_;
+    Logger logger_{registry_};
+};
+
+TEST_F(LoggerTest, FormatsOnLoggerThread) {
+    logger_.log(LogLevel::WARNING, "motor 0x%02X", 0x11);
+    EXPECT_EQ(messages(), std::vector<std::string>{"WARNING: motor 0x11"});
+    EXPECT_EQ(logger_.get_messages(), 1u);
+}
+
+TEST_F(LoggerTest, FiltersByLevel) {
+    logger_.set_level(LogLevel::ERROR);
+    logger_.log(LogLevel::WARNING, "hidden");
+    logger_.log(LogLevel::ERROR, "shown");
+    EXPECT_EQ(messages(), std::vector<std::string>{"ERROR: shown"});
+}
+
+TEST_F(LoggerTest, ThrottleReportsSuppressedCount) {
+    LogThrottle throttle(60LL * 1000000000);
+    for (int i = 0; i < 1000; ++i) logger_.log(throttle, LogLevel::WARNING, "rejected");
+    EXPECT_EQ(messages(), std::vector<std::string>{"WARNING: rejected"});
+    EXPECT_EQ(logger_.get_suppressed(), 999u);
+}
+
+TEST_F(LoggerTest, FullQueueDropsInsteadOfBlocking) {
+    std::mutex gate;
+    gate.lock();
+    logger_.set_sink([&gate](LogLevel, const char*) { std::lock_guard<std::mutex> lock(gate); });
+    for (size_t i = 0; i < Logger::kQueueSize * 2; ++i) logger_.log(LogLevel::INFO, "flood");
+    EXPECT_GT(logger_.get_dropped(), 0u);
+    EXPECT_EQ(logger_.get_messages() + logger_.get_dropped(), Logger::kQueueSize * 2);
+    gate.unlock();
+    logger_.flush();
+    logger_.set_sink([](LogLevel, const char*) {});
+}
+
+TEST_F(LoggerTest, TruncatesLongMessages) {
+    std::string long_text(Logger::kMaxMessageLength * 2, 'x');
+    logger_.log(LogLevel::INFO, "%s", long_text.c_str());
+    auto logged = messages();
+    ASSERT_EQ(logged.size(), 1u);
+    EXPECT_EQ(logged[0].size(), std::string("INFO: ").size() + Logger::kMaxMessageLength - 1);
+}
+
+}  // namespace
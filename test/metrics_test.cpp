@@ -0,0 +1,104 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <openarm/canbus/can_device_collection.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/canbus/metrics.hpp>
+#include <openarm/damiao_motor/dm_motor_device.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using openarm::canbus::MetricsRegistry;
+
+TEST(MetricsRegistryTest, RendersTextFormat) {
+    MetricsRegistry registry;
+    registry.counter("b_total", "Counted things", {{"interface", "can0"}}).inc(3);
+    registry.gauge("a_value", "Current \\ value").set(1.5);
+    EXPECT_EQ(registry.render(),
+              "# HELP a_value Current \\\\ value\n"
+              "# TYPE a_value gauge\n"
+              "a_value 1.5\n"
+              "# HELP b_total Counted things\n"
+              "# TYPE b_total counter\n"
+              "b_total{interface=\"can0\"} 3\n");
+}
+
+TEST(MetricsRegistryTest, SameSeriesIsShared) {
+    MetricsRegistry registry;
+    auto& first = registry.counter("frames_total", "Frames", {{"id", "1"}});
+    auto& second = registry.counter("frames_total", "Frames", {{"id", "1"}});
+    auto& other = registry.counter("frames_total", "Frames", {{"id", "2"}});
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, &other);
+    EXPECT_THROW(registry.gauge("frames_total", "Frames"), std::invalid_argument);
+}
+
+TEST(MetricsRegistryTest, EscapesLabelValues) {
+    MetricsRegistry registry;
+    registry.counter("c_total", "C", {{"name", "a\"b\\c\nd"}}).inc();
+    EXPECT_NE(registry.render().find("c_total{name=\"a\\\"b\\\\c\\nd\"} 1\n"), std::string::npos);
+}
+
+TEST(MetricsRegistryTest, WritesTextfile) {
+    MetricsRegistry registry;
+    registry.counter("written_total", "W").inc(7);
+    std::string path = testing::TempDir() + "openarm_metrics_test.prom";
+    ASSERT_TRUE(registry.write_textfile(path));
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ(contents.str(), registry.render());
+    EXPECT_NE(access((path + ".tmp").c_str(), F_OK), 0);
+    unlink(path.c_str());
+}
+
+TEST(MetricsRegistryTest, CountsDeviceTraffic) {
+    using namespace openarm::damiao_motor;
+    openarm::canbus::LoopbackTransport transport(false, "metrics_test0");
+    openarm::canbus::CANDeviceCollection collection(transport);
+    Motor motor(MotorType::DM4310, 0x01, 0x11);
+    auto device = std::make_shared<DMCANDevice>(motor, CAN_SFF_MASK, false);
+    device->record_tx(true);
+    collection.add_device(device);
+    device->record_tx(true);
+
+    can_frame reply{};
+    reply.can_id = 0x11;
+    reply.can_dlc = 8;
+    collection.dispatch_frame_callback(reply);
+    can_frame unknown{};
+    unknown.can_id = 0x42;
+    collection.dispatch_frame_callback(unknown);
+    collection.dispatch_frame_callback(unknown);
+
+    std::string text = MetricsRegistry::global().render();
+    EXPECT_NE(text.find("openarm_can_device_tx_frames_total{interface=\"metrics_test0\","
+                        "send_id=\"0x01\",recv_id=\"0x11\"} 2\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("openarm_can_device_rx_frames_total{interface=\"metrics_test0\","
+                        "send_id=\"0x01\",recv_id=\"0x11\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("openarm_can_unknown_id_frames_total{interface=\"metrics_test0\"} 2\n"),
+              std::string::npos);
+    EXPECT_EQ(collection.get_unknown_id_frames(), 2u);
+}
+
+}  // namespace
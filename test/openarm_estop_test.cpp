@@ -0,0 +1,140 @@
+// Copyright 2026 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/fault_injection_transport.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using openarm::can::socket::OpenArm;
+using openarm::canbus::FaultInjectionTransport;
+using openarm::canbus::FaultProfile;
+using openarm::canbus::LoopbackTransport;
+using openarm::damiao_motor::MotorType;
+
+std::unique_ptr<OpenArm> make_openarm() {
+    auto openarm = std::make_unique<OpenArm>(std::make_unique<LoopbackTransport>(false, "estop"));
+    openarm->init_arm_motors({MotorType::DM4310, MotorType::DM4310}, {0x01, 0x02},
+                             {0x11, 0x12});
+    return openarm;
+}
+
+}  // namespace
+
+TEST(OpenArmEStopTest, EStopWritesDisableForRegisteredMotors) {
+    auto openarm = make_openarm();
+    auto result = openarm->estop();
+    EXPECT_EQ(result.frames_queued, 2);
+    EXPECT_EQ(result.frames_failed, 0);
+
+    openarm->init_gripper_motor(MotorType::DM4310, 0x08, 0x18);
+    result = openarm->estop();
+    EXPECT_EQ(result.frames_queued, 3);
+}
+
+TEST(OpenArmEStopTest, EStopAllWhileInstancesComeAndGo) {
+    std::atomic<bool> stop{false};
+    std::thread estopper([&] {
+        while (!stop.load()) OpenArm::estop_all();
+    });
+    for (int i = 0; i < 200; ++i) {
+        auto openarm = make_openarm();
+        openarm->init_gripper_motor(MotorType::DM4310, 0x08, 0x18);
+    }
+    stop.store(true);
+    estopper.join();
+}
+
+TEST(OpenArmEStopTest, OverlappingEStopAllCallsDoNotStallDestruction) {
+    auto long_lived = make_openarm();
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> watchdogs;
+    for (int i = 0; i < 2; ++i) {
+        watchdogs.emplace_back([&] {
+            while (!stop.load()) OpenArm::estop_all();
+        });
+    }
+    for (int i = 0; i < 200; ++i) make_openarm();
+    stop.store(true);
+    for (auto& watchdog : watchdogs) watchdog.join();
+}
+
+TEST(OpenArmEStopTest, EStopAllSkipsInstancesBeyondCapacity) {
+    std::vector<std::unique_ptr<OpenArm>> openarms;
+    for (size_t i = 0; i < OpenArm::kMaxEStopInstances + 1; ++i) {
+        openarms.push_back(make_openarm());
+    }
+    // LoopbackTransport is not async-signal-safe, so the disables are deferred
+    auto result = OpenArm::estop_all();
+    EXPECT_EQ(result.frames_queued, 0);
+    EXPECT_EQ(result.frames_deferred, static_cast<int>(2 * OpenArm::kMaxEStopInstances));
+}
+
+TEST(OpenArmEStopTest, EStopAllDefersDisablesOnUnsafeTransports) {
+    LoopbackTransport near(false, "estop");
+    LoopbackTransport far;
+    LoopbackTransport::connect(near, far);
+    OpenArm openarm(std::make_unique<FaultInjectionTransport>(near));
+    openarm.init_arm_motors({MotorType::DM4310}, {0x01}, {0x11});
+    EXPECT_FALSE(openarm.get_transport().is_async_signal_safe());
+
+    auto result = OpenArm::estop_all();
+    EXPECT_EQ(result.frames_deferred, 1);
+    EXPECT_EQ(far.rx_pending(), 0u);
+    EXPECT_EQ(openarm.get_tx_scheduler().stop_pending(), 1u);
+
+    openarm.recv_all(0);
+    can_frame frame;
+    ASSERT_TRUE(far.read_can_frame(frame));
+    EXPECT_EQ(frame.data[7], 0xFD);
+    EXPECT_EQ(openarm.get_tx_scheduler().stop_pending(), 0u);
+}
+
+TEST(OpenArmEStopTest, EStopOvertakesEnableQueuedUnderBackpressure) {
+    LoopbackTransport near(false, "estop");
+    LoopbackTransport far;
+    LoopbackTransport::connect(near, far);
+    auto transport = std::make_unique<FaultInjectionTransport>(near);
+    FaultInjectionTransport& faulty = *transport;
+    OpenArm openarm(std::move(transport));
+    openarm.init_arm_motors({MotorType::DM4310}, {0x01}, {0x11});
+
+    FaultProfile refusing;
+    refusing.refuse_probability = 1.0;
+    faulty.set_tx_profile(refusing);
+    openarm.enable_all();
+    auto result = openarm.estop();
+    EXPECT_EQ(result.frames_queued, 0);
+    EXPECT_EQ(result.frames_failed, 1);
+    openarm.recv_all(0);
+    EXPECT_EQ(far.rx_pending(), 0u);
+
+    faulty.set_tx_profile(FaultProfile());
+    openarm.recv_all(0);
+    std::vector<can_frame> wire;
+    can_frame frame;
+    while (far.read_can_frame(frame)) wire.push_back(frame);
+    // The disable goes out and the enable queued before the estop never does
+    ASSERT_EQ(wire.size(), 1u);
+    EXPECT_EQ(wire[0].can_id, 0x01u);
+    EXPECT_EQ(wire[0].data[7], 0xFD);
+    EXPECT_EQ(openarm.get_tx_scheduler().pending(), 0u);
+    EXPECT_EQ(openarm.get_tx_scheduler().stop_pending(), 0u);
+}
@@ -0,0 +1,197 @@
+// Copyright 2025 Enactic, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <openarm/can/socket/openarm.hpp>
+#include <openarm/canbus/loopback_transport.hpp>
+#include <openarm/canbus/trace.hpp>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using openarm::canbus::TraceRecorder;
+using openarm::canbus::TraceScope;
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override { path_ = testing::TempDir() + "openarm_trace_test.json"; }
+    void TearDown() override {
+        TraceRecorder::set_active(nullptr);
+        unlink(path_.c_str());
+    }
+
+    std::string read_trace() {
+        std::ifstream file(path_);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    // Names of the complete events in a closed trace file
+    std::vector<std::string> event_names() {
+        std::string trace = read_trace();
+        std::regex event_regex(
+            R"re(\{"name":"([^"]+)","cat":"[^"]+","ph":"X","ts":[0-9.]+,"dur":[0-9.]+,)re"
+            R"re("pid":[0-9]+,"tid":[0-9]+\})re");
+        std::vector<std::string> names;
+        for (auto it = std::sregex_iterator(trace.begin(), trace.end(), event_regex);
+             it != std::sregex_iterator(); ++it) {
+            names.push_back((*it)[1]);
+        }
+        return names;
+    }
+
+    std::string path_;
+};
+
+TEST_F(TraceTest, WritesCompleteEvents) {
+    {
+        TraceRecorder recorder(path_);
+        recorder.record("test", "first", 1000, 2500);
+        recorder.record("test", "second", 5000, 1);
+        recorder.flush();
+        EXPECT_EQ(recorder.get_recorded(), 2u);
+        EXPECT_EQ(recorder.get_dropped(), 0u);
+    }
+    std::string trace = read_trace();
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(trace.find("\"ts\":1.000,\"dur\":2.500"), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+    EXPECT_EQ(event_names(), (std::vector<std::string>{"first", "second"}));
+}
+
+TEST_F(TraceTest, ScopesAreIgnoredWhileInactive) {
+    {
+        TraceRecorder recorder(path_);
+        { TraceScope scope("test", "ignored"); }
+        TraceRecorder::set_active(&recorder);
+        { TraceScope scope("test", "traced"); }
+        TraceRecorder::set_active(nullptr);
+        { TraceScope scope("test", "ignored"); }
+        EXPECT_EQ(recorder.get_recorded(), 1u);
+    }
+    EXPECT_EQ(event_names(), std::vector<std::string>{"traced"});
+}
+
+TEST_F(TraceTest, DestructorDeactivates) {
+    {
+        TraceRecorder recorder(path_);
+        TraceRecorder::set_active(&recorder);
+    }
+    EXPECT_EQ(TraceRecorder::active(), nullptr);
+}
+
+TEST_F(TraceTest, DropsWhenFull) {
+    uint64_t recorded;
+    {
+        TraceRecorder recorder(path_, 4, 1000);
+        for (int i = 0; i < 100; ++i) recorder.record("test", "event", i, 1);
+        recorded = recorder.get_recorded();
+        EXPECT_GT(recorder.get_dropped(), 0u);
+        EXPECT_EQ(recorded + recorder.get_dropped(), 100u);
+    }
+    EXPECT_EQ(event_names().size(), recorded);
+}
+
+TEST_F(TraceTest, TracesControlCyclePhases) {
+    auto transport = std::make_unique<openarm::canbus::LoopbackTransport>(false, "trace_test");
+    openarm::canbus::LoopbackTransport motor_side(false, "trace_test");
+    openarm::canbus::LoopbackTransport::connect(*transport, motor_side);
+    openarm::can::socket::OpenArm openarm(std::move(transport));
+    openarm.init_arm_motors({openarm::damiao_motor::MotorType::DM4310}, {0x01}, {0x11});
+
+    {
+        TraceRecorder recorder(path_);
+        TraceRecorder::set_active(&recorder);
+        openarm.get_arm().mit_control_all({{0, 0, 0, 0, 0}});
+        openarm.recv_all(0);
+        TraceRecorder::set_active(nullptr);
+    }
+    auto names = event_names();
+    std::set<std::string> phases(names.begin(), names.end());
+    for (const char* phase :
+         {"mit_control_all", "encode", "send_command_to_device", "recv_all", "flush_tx", "wait"}) {
+        EXPECT_EQ(phases.count(phase), 1u) << phase;
+    }
+}
+
+TEST_F(TraceTest, DestructorWaitsForScopesOnOtherThreads) {
+    auto recorder = std::make_unique<TraceRecorder>(path_);
+    TraceRecorder::set_active(recorder.get());
+    std::atomic<bool> opened{false};
+    std::thread worker([&] {
+        TraceScope scope("test", "straddling");
+        opened.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+    while (!opened.load()) std::this_thread::yield();
+
+    auto start = std::chrono::steady_clock::now();
+    recorder.reset();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    worker.join();
+    EXPECT_EQ(event_names(), (std::vector<std::string>{"straddling"}));
+}
+
+TEST_F(TraceTest, RecordersComeAndGoUnderOpeningScopes) {
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 2; ++i) {
+        workers.emplace_back([&] {
+            while (!stop.load()) TraceScope scope("test", "churn");
+        });
+    }
+    for (int i = 0; i < 20; ++i) {
+        auto recorder = std::make_unique<TraceRecorder>(path_);
+        TraceRecorder::set_active(recorder.get());
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    stop.store(true);
+    for (auto& worker : workers) worker.join();
+    std::string trace = read_trace();
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+TEST_F(TraceTest, ScopesOnTheDestroyingThreadAreDropped) {
+    {
+        TraceScope outer("test", "outer");
+        auto recorder = std::make_unique<TraceRecorder>(path_);
+        TraceRecorder::set_active(recorder.get());
+        TraceScope inner("test", "inner");
+        recorder.reset();
+        // Nested under a detached scope, so not traced either
+        auto next = std::make_unique<TraceRecorder>(path_ + ".next");
+        TraceRecorder::set_active(next.get());
+        { TraceScope nested("test", "nested"); }
+        EXPECT_EQ(next->get_recorded(), 0u);
+        next.reset();
+        unlink((path_ + ".next").c_str());
+    }
+    EXPECT_TRUE(event_names().empty());
+    std::string trace = read_trace();
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+}  // namespace